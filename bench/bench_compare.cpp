@@ -0,0 +1,85 @@
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bench_stats.h"
+
+// Compares two vastgpu_bench --json runs and exits non-zero if any kernel got significantly slower
+
+static void usage() {
+    std::cerr << "Usage: vastgpu_bench_compare <before.json> <after.json> [--max-slowdown <ratio>] [--alpha <p>]\n"
+              << "  --max-slowdown <ratio>  Median ratio a regression must exceed (default 1.10)\n"
+              << "  --alpha <p>             Mann-Whitney significance level (default 0.01)\n";
+}
+
+static std::vector<BenchmarkSamples> readRun(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Can't open " + path);
+    }
+    return readBenchmarkJson(in);
+}
+
+static bool parsePositive(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return *end == '\0' && value > 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> paths;
+    BenchmarkCompareConfig config;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--max-slowdown" && i + 1 < argc) {
+            if (!parsePositive(argv[++i], config.maxSlowdown)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--alpha" && i + 1 < argc) {
+            if (!parsePositive(argv[++i], config.significance)) {
+                usage();
+                return 1;
+            }
+        } else if (arg.rfind("--", 0) != 0) {
+            paths.push_back(arg);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (paths.size() != 2) {
+        usage();
+        return 1;
+    }
+
+    std::vector<BenchmarkComparison> comparisons;
+    try {
+        comparisons = compareBenchmarks(readRun(paths[0]), readRun(paths[1]), config);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    int regressions = 0;
+    std::string intervalLabel = std::to_string((int)(config.confidence * 100.0 + 0.5)) + "% interval";
+    std::cout << std::left << std::setw(36) << "kernel" << std::right << std::setw(12) << "before ns"
+              << std::setw(12) << "after ns" << std::setw(9) << "ratio" << std::setw(20) << intervalLabel
+              << std::setw(11) << "p" << "\n";
+    for (const auto& c : comparisons) {
+        std::cout << std::left << std::setw(36) << c.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << c.beforeMedian << std::setw(12) << c.afterMedian << std::setprecision(3)
+                  << std::setw(9) << c.ratio << std::setw(10) << c.ratioInterval.low << std::setw(10)
+                  << c.ratioInterval.high << std::scientific << std::setprecision(2) << std::setw(11) << c.pValue
+                  << std::defaultfloat << (c.regressed ? "  REGRESSION" : "") << "\n";
+        regressions += c.regressed ? 1 : 0;
+    }
+    if (regressions > 0) {
+        std::cout << regressions << " kernel(s) slower than " << config.maxSlowdown << "x" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "batch_kernels.h"
+#include "bench_stats.h"
+#include "fleet_aggregation.h"
+#include "funds_calculator.h"
+#include "gpu_model.h"
+#include "kernel_profiler.h"
+#include "pricing_rule.h"
+#include "tiered_pricing.h"
+
+// Calculator kernels over a synthetic mixed fleet: a quarter of the rows are idle storage-only
+// boxes, a quarter compute-only, the rest both, as in the catalogs we price.
+struct BenchFleet {
+    std::vector<GpuModel> gpuModels;
+    std::vector<double> initialFunds;
+    std::vector<double> hourlyRates;
+    std::vector<double> dailyStorageCosts;
+    std::vector<int> instanceCounts;
+    std::vector<int> runningHours;
+};
+
+struct BenchKernel {
+    std::string name;
+    std::uint64_t calls;
+    std::function<void()> run;
+};
+
+static BenchFleet makeFleet(std::size_t rows) {
+    const char* names[] = {"A100", "H100", "V100", "RTX4090", "L40S", "T4"};
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> funds(100.0, 50000.0);
+    std::uniform_real_distribution<double> rate(0.1, 4.0);
+    std::uniform_real_distribution<double> storage(0.05, 2.0);
+    std::uniform_int_distribution<int> instances(1, 16);
+    std::uniform_int_distribution<int> hours(1, 2000);
+
+    BenchFleet fleet;
+    for (std::size_t i = 0; i < rows; i++) {
+        double r = i % 4 == 0 ? 0.0 : rate(rng);
+        double s = i % 4 == 1 ? 0.0 : storage(rng);
+        int n = instances(rng);
+        fleet.gpuModels.push_back(GpuModel(names[i % 6], r, s, n));
+        fleet.initialFunds.push_back(funds(rng));
+        fleet.hourlyRates.push_back(r);
+        fleet.dailyStorageCosts.push_back(s);
+        fleet.instanceCounts.push_back(n);
+        fleet.runningHours.push_back(hours(rng));
+    }
+    return fleet;
+}
+
+static void usage() {
+    std::cerr << "Usage: vastgpu_bench [--rows <count>] [--repeat <count>] [--json <file>] [--profile]\n"
+              << "  --rows <count>    Fleet size (default 1000000)\n"
+              << "  --repeat <count>  Times to run each kernel (default 1)\n"
+              << "  --json <file>     Write every run's ns per call for vastgpu_bench_compare\n"
+              << "  --profile         Read hardware counters as well as the clock\n";
+}
+
+static bool parseCount(const char* text, std::size_t& count) {
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (*end != '\0' || value <= 0) {
+        return false;
+    }
+    count = (std::size_t)(value);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::size_t rows = 1000000;
+    std::size_t repeat = 1;
+    std::string jsonPath;
+    bool profile = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--profile") {
+            profile = true;
+        } else if (arg == "--rows" && i + 1 < argc) {
+            if (!parseCount(argv[++i], rows)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            if (!parseCount(argv[++i], repeat)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    BenchFleet fleet = makeFleet(rows);
+    KernelProfiler profiler(profile);
+    volatile double sink = 0.0;
+    std::vector<double> results(rows);
+
+    std::vector<BenchKernel> kernels;
+    kernels.push_back(BenchKernel{"calculateTotalCost", rows, [&]() {
+        double total = 0.0;
+        for (std::size_t i = 0; i < rows; i++) {
+            total += calculateTotalCost(fleet.hourlyRates[i], fleet.instanceCounts[i], fleet.runningHours[i],
+                                        fleet.dailyStorageCosts[i]);
+        }
+        sink = total;
+    }});
+    kernels.push_back(BenchKernel{"calculateFundsDuration", rows, [&]() {
+        double total = 0.0;
+        for (std::size_t i = 0; i < rows; i++) {
+            total += calculateFundsDuration(fleet.initialFunds[i], fleet.hourlyRates[i], fleet.instanceCounts[i],
+                                            fleet.dailyStorageCosts[i]);
+        }
+        sink = total;
+    }});
+    kernels.push_back(BenchKernel{"calculateFundsDurationBatch", rows, [&]() {
+        calculateFundsDurationBatch(fleet.initialFunds.data(), fleet.hourlyRates.data(), fleet.instanceCounts.data(),
+                                    fleet.dailyStorageCosts.data(), rows, results.data());
+    }});
+    kernels.push_back(BenchKernel{"calculateTotalCostMultipleGpus", 1, [&]() {
+        sink = calculateTotalCostMultipleGpus(fleet.gpuModels, 720);
+    }});
+    kernels.push_back(BenchKernel{"calculateFundsDurationMultipleGpus", 1, [&]() {
+        sink = calculateFundsDurationMultipleGpus(1e9, fleet.gpuModels);
+    }});
+    kernels.push_back(BenchKernel{"aggregateFleetByModel", 1, [&]() {
+        sink = aggregateFleetByModel(fleet.gpuModels, 720).totalCost;
+    }});
+
+    PricingRule rule("rate * instances * hours + storage * instances * days");
+    kernels.push_back(BenchKernel{"PricingRule::evaluateBatch", rows, [&]() {
+        rule.evaluateBatch(fleet.hourlyRates.data(), fleet.instanceCounts.data(), fleet.runningHours.data(),
+                           fleet.dailyStorageCosts.data(), rows, results.data());
+    }});
+    kernels.push_back(BenchKernel{"PricingRule::evaluate", rows, [&]() {
+        double total = 0.0;
+        for (std::size_t i = 0; i < rows; i++) {
+            total += rule.evaluate(fleet.hourlyRates[i], fleet.instanceCounts[i], fleet.runningHours[i],
+                                   fleet.dailyStorageCosts[i]);
+        }
+        sink = total;
+    }});
+
+    TieredRateTable tiers({1, 4, 8}, {0, 100, 500}, {2.0, 1.8, 1.5, 1.9, 1.7, 1.4, 1.8, 1.6, 1.2});
+    kernels.push_back(BenchKernel{"calculateTieredTotalCost", rows, [&]() {
+        double total = 0.0;
+        for (std::size_t i = 0; i < rows; i++) {
+            total += calculateTieredTotalCost(tiers, fleet.instanceCounts[i], fleet.runningHours[i],
+                                              fleet.dailyStorageCosts[i]);
+        }
+        sink = total;
+    }});
+
+    // Runs are interleaved across kernels after one discarded warm-up run each, so a slow phase
+    // of a busy machine is spread over every kernel's samples instead of landing on one kernel
+    std::vector<BenchmarkSamples> samples;
+    for (const auto& kernel : kernels) {
+        kernel.run();
+        samples.push_back(BenchmarkSamples{kernel.name, {}});
+    }
+    for (std::size_t run = 0; run < repeat; run++) {
+        for (std::size_t k = 0; k < kernels.size(); k++) {
+            const BenchKernel& kernel = kernels[k];
+            double before = profiler.getProfiles().count(kernel.name) ? profiler.getProfiles().at(kernel.name).seconds
+                                                                      : 0.0;
+            profiler.measure(kernel.name, kernel.calls, kernel.run);
+            double seconds = profiler.getProfiles().at(kernel.name).seconds - before;
+            samples[k].nanosPerCall.push_back(seconds * 1e9 / (double)(kernel.calls));
+        }
+    }
+
+    std::cout << rows << " fleet rows" << std::endl;
+    profiler.printReport(std::cout);
+
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        writeBenchmarkJson(out, samples);
+        if (!out) {
+            std::cerr << "Error: can't write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "batch_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+enum class DurationCase { NoFunds, Indefinite, StorageOnly, ComputeOnly, Mixed, Count };
+
+// R and S below are already multiplied by the instance count
+template <DurationCase Case>
+double durationKernel(double funds, double R, double S);
+
+template <>
+double durationKernel<DurationCase::NoFunds>(double, double, double) {
+    return 0.0;
+}
+
+template <>
+double durationKernel<DurationCase::Indefinite>(double, double, double) {
+    return -1;
+}
+
+template <>
+double durationKernel<DurationCase::StorageOnly>(double funds, double, double S) {
+    return (funds / S) * 24.0;
+}
+
+template <>
+double durationKernel<DurationCase::ComputeOnly>(double funds, double R, double) {
+    return funds / R;
+}
+
+template <>
+double durationKernel<DurationCase::Mixed>(double funds, double R, double S) {
+    return detail::mixedFundsDuration(funds, R, S);
+}
+
+DurationCase classify(double funds, double R, double S) {
+    if (funds == 0) {
+        return DurationCase::NoFunds;
+    }
+    if (R <= 0 && S <= 0) {
+        return DurationCase::Indefinite;
+    }
+    if (R <= 0) {
+        return DurationCase::StorageOnly;
+    }
+    return S <= 0 ? DurationCase::ComputeOnly : DurationCase::Mixed;
+}
+
+template <DurationCase Case>
+void runPartition(const std::vector<std::size_t>& rows, const double* initialFunds, const double* hourlyRates,
+                  const int* instanceCounts, const double* dailyStorageCosts, double* durations) {
+    std::size_t count = rows.size();
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t row = rows[i];
+        double instances = (double)(instanceCounts[row]);
+        durations[row] = durationKernel<Case>(initialFunds[row], hourlyRates[row] * instances,
+                                              dailyStorageCosts[row] * instances);
+    }
+}
+
+} // namespace
+
+void calculateFundsDurationBatch(const double* initialFunds, const double* hourlyRates, const int* instanceCounts,
+                                 const double* dailyStorageCosts, std::size_t count, double* durations) {
+    // Input validation
+    for (std::size_t i = 0; i < count; i++) {
+        if (initialFunds[i] < 0) {
+            throw std::invalid_argument("Initial funds can't be negative");
+        }
+        if (instanceCounts[i] <= 0) {
+            throw std::invalid_argument("Instance count must be positive");
+        }
+        if (hourlyRates[i] < 0) {
+            throw std::invalid_argument("Hourly rate can't be negative");
+        }
+        if (dailyStorageCosts[i] < 0) {
+            throw std::invalid_argument("Daily storage cost can't be negative");
+        }
+    }
+
+    std::vector<std::size_t> partitions[(int)(DurationCase::Count)];
+    for (std::size_t i = 0; i < count; i++) {
+        DurationCase rowCase = classify(initialFunds[i], hourlyRates[i], dailyStorageCosts[i]);
+        partitions[(int)(rowCase)].push_back(i);
+    }
+
+    runPartition<DurationCase::NoFunds>(partitions[(int)(DurationCase::NoFunds)],
+                                        initialFunds, hourlyRates, instanceCounts, dailyStorageCosts, durations);
+    runPartition<DurationCase::Indefinite>(partitions[(int)(DurationCase::Indefinite)],
+                                           initialFunds, hourlyRates, instanceCounts, dailyStorageCosts, durations);
+    runPartition<DurationCase::StorageOnly>(partitions[(int)(DurationCase::StorageOnly)],
+                                            initialFunds, hourlyRates, instanceCounts, dailyStorageCosts, durations);
+    runPartition<DurationCase::ComputeOnly>(partitions[(int)(DurationCase::ComputeOnly)],
+                                            initialFunds, hourlyRates, instanceCounts, dailyStorageCosts, durations);
+    runPartition<DurationCase::Mixed>(partitions[(int)(DurationCase::Mixed)],
+                                      initialFunds, hourlyRates, instanceCounts, dailyStorageCosts, durations);
+}
+
+double closedFormFundsDuration(double initialFunds, double totalHourlyRate, double totalDailyStorageCost) {
+    // Input validation
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (totalHourlyRate < 0) {
+        throw std::invalid_argument("Hourly rate can't be negative");
+    }
+    if (totalDailyStorageCost < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+
+    switch (classify(initialFunds, totalHourlyRate, totalDailyStorageCost)) {
+    case DurationCase::NoFunds:
+        return durationKernel<DurationCase::NoFunds>(initialFunds, totalHourlyRate, totalDailyStorageCost);
+    case DurationCase::Indefinite:
+        return durationKernel<DurationCase::Indefinite>(initialFunds, totalHourlyRate, totalDailyStorageCost);
+    case DurationCase::StorageOnly:
+        return durationKernel<DurationCase::StorageOnly>(initialFunds, totalHourlyRate, totalDailyStorageCost);
+    case DurationCase::ComputeOnly:
+        return durationKernel<DurationCase::ComputeOnly>(initialFunds, totalHourlyRate, totalDailyStorageCost);
+    default:
+        return durationKernel<DurationCase::Mixed>(initialFunds, totalHourlyRate, totalDailyStorageCost);
+    }
+}
+
+double fundsExhaustedAt(double hour, double funds, double totalHourlyRate, double totalDailyStorageCost) {
+    if (funds <= 0) {
+        return hour;
+    }
+    if (totalHourlyRate <= 0) {
+        return hour + funds / (totalDailyStorageCost / 24.0);
+    }
+    double dayEnd = std::ceil(hour / 24.0) * 24.0;
+    if (dayEnd > hour) {
+        // Finish the day already paid for, then continue from its end in closed form
+        if (funds <= totalHourlyRate * (dayEnd - hour)) {
+            return hour + funds / totalHourlyRate;
+        }
+        funds -= totalHourlyRate * (dayEnd - hour);
+        hour = dayEnd;
+    }
+    return hour + closedFormFundsDuration(funds, totalHourlyRate, totalDailyStorageCost);
+}
+
+double spendBetween(double hour, double laterHour, double totalHourlyRate, double totalDailyStorageCost) {
+    if (totalHourlyRate <= 0) {
+        return totalDailyStorageCost / 24.0 * (laterHour - hour);
+    }
+    return totalHourlyRate * (laterHour - hour) +
+           totalDailyStorageCost * (std::ceil(laterHour / 24.0) - std::ceil(hour / 24.0));
+}
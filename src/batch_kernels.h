@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// Runway for many independent configurations at once, result[i] being
+//     calculateFundsDuration(initialFunds[i], hourlyRates[i], instanceCounts[i], dailyStorageCosts[i])
+// Inputs are validated first with the scalar function's rules and messages. Rows are then
+// partitioned once by case (no funds, no ongoing cost, storage-only, compute-only, mixed) and
+// each partition runs its own branch-free loop; results are scattered back to input order.
+// Compute-only and mixed rows use the closed form of the scalar function's day loop, so they
+// agree with it up to floating point rounding.
+void calculateFundsDurationBatch(const double* initialFunds, const double* hourlyRates, const int* instanceCounts,
+                                 const double* dailyStorageCosts, std::size_t count, double* durations);
+
+// Closed-form runway for a fleet burning totalHourlyRate per hour with totalDailyStorageCost
+// charged at the start of each day; same result as calculateFundsDuration(funds, rate, 1, storage).
+double closedFormFundsDuration(double initialFunds, double totalHourlyRate, double totalDailyStorageCost);
+
+// Mid-runway forms of the same burn, for a balance held at a given hour. That balance has already
+// paid storage for its day unless the hour is a day boundary; with no hourly rate, storage is
+// spent at dailyStorageCost / 24 per hour as in calculateFundsDuration.
+// Hour at which funds held at the given hour run out
+double fundsExhaustedAt(double hour, double funds, double totalHourlyRate, double totalDailyStorageCost);
+// Spend from hour up to laterHour, not including the storage due at laterHour
+double spendBetween(double hour, double laterHour, double totalHourlyRate, double totalDailyStorageCost);
+
+namespace detail {
+
+// Runway of a fleet with R > 0 and S > 0 (fleet totals), in the closed form of the scalar day
+// loop. It completes day j (0-based) exactly when funds - j * (S + 24R) - S > 24R, so the number
+// of complete days is max(0, ceil((funds - S - 24R) / (S + 24R))), after which the rest of the
+// funds (less that day's storage) run for at most 24 more hours. Number is double, or a type
+// such as Interval with the same operators and ceil/min/max found by argument-dependent lookup.
+template <typename Number>
+Number mixedFundsDuration(const Number& funds, const Number& R, const Number& S) {
+    using std::ceil;
+    using std::max;
+    using std::min;
+    Number dayCost = S + Number(24.0) * R;
+    Number fullDays = max(Number(0.0), ceil((funds - S - Number(24.0) * R) / dayCost));
+    Number lastDay = funds - fullDays * dayCost - S;
+    Number lastDayHours = min(Number(24.0), max(Number(0.0), lastDay) / R);
+    return fullDays * Number(24.0) + lastDayHours;
+}
+
+} // namespace detail
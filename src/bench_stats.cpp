@@ -0,0 +1,290 @@
+#include "bench_stats.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if ((unsigned char)(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Just enough JSON for the benchmark file: objects, arrays, strings and numbers
+class JsonCursor {
+public:
+    explicit JsonCursor(const std::string& text) : text(text) {
+    }
+
+    void expect(char c) {
+        skipSpace();
+        if (pos >= text.size() || text[pos] != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        pos++;
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (pos < text.size() && text[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    std::string readString() {
+        expect('"');
+        std::string value;
+        while (pos < text.size() && text[pos] != '"') {
+            if (text[pos] == '\\' && pos + 1 < text.size()) {
+                pos++;
+            }
+            value += text[pos++];
+        }
+        expect('"');
+        return value;
+    }
+
+    double readNumber() {
+        skipSpace();
+        const char* begin = text.c_str() + pos;
+        char* end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin || !std::isfinite(value)) {
+            fail("expected a number");
+        }
+        pos += (std::size_t)(end - begin);
+        return value;
+    }
+
+    void expectEnd() {
+        skipSpace();
+        if (pos != text.size()) {
+            fail("trailing characters");
+        }
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("Benchmark JSON: " + message + " at offset " + std::to_string(pos));
+    }
+
+private:
+    void skipSpace() {
+        while (pos < text.size() && std::isspace((unsigned char)(text[pos]))) {
+            pos++;
+        }
+    }
+
+    const std::string& text;
+    std::size_t pos = 0;
+};
+
+BenchmarkSamples readBenchmark(JsonCursor& cursor) {
+    BenchmarkSamples benchmark;
+    bool haveName = false;
+    cursor.expect('{');
+    do {
+        std::string key = cursor.readString();
+        cursor.expect(':');
+        if (key == "name") {
+            benchmark.name = cursor.readString();
+            haveName = true;
+        } else if (key == "ns_per_call") {
+            cursor.expect('[');
+            if (!cursor.accept(']')) {
+                do {
+                    benchmark.nanosPerCall.push_back(cursor.readNumber());
+                } while (cursor.accept(','));
+                cursor.expect(']');
+            }
+        } else {
+            cursor.fail("unknown key \"" + key + "\"");
+        }
+    } while (cursor.accept(','));
+    cursor.expect('}');
+    if (!haveName) {
+        cursor.fail("benchmark without a name");
+    }
+    return benchmark;
+}
+
+// Ranks of the pooled samples (1-based, ties averaged) and the tie correction sum of t^3 - t
+double rankSumOfAfter(const std::vector<double>& before, const std::vector<double>& after, double& tieTerm) {
+    std::vector<std::pair<double, bool>> pooled;
+    for (double x : before) {
+        pooled.emplace_back(x, false);
+    }
+    for (double x : after) {
+        pooled.emplace_back(x, true);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    double rankSum = 0.0;
+    tieTerm = 0.0;
+    std::size_t i = 0;
+    while (i < pooled.size()) {
+        std::size_t j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+            j++;
+        }
+        double ties = (double)(j - i);
+        double averageRank = ((double)(i + 1) + (double)(j)) / 2.0;
+        for (std::size_t k = i; k < j; k++) {
+            if (pooled[k].second) {
+                rankSum += averageRank;
+            }
+        }
+        tieTerm += ties * ties * ties - ties;
+        i = j;
+    }
+    return rankSum;
+}
+
+} // namespace
+
+void writeBenchmarkJson(std::ostream& out, const std::vector<BenchmarkSamples>& benchmarks) {
+    std::streamsize precision = out.precision(10);
+    out << "{\"benchmarks\": [";
+    for (std::size_t i = 0; i < benchmarks.size(); i++) {
+        out << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+        writeJsonString(out, benchmarks[i].name);
+        out << ", \"ns_per_call\": [";
+        for (std::size_t j = 0; j < benchmarks[i].nanosPerCall.size(); j++) {
+            out << (j == 0 ? "" : ", ") << benchmarks[i].nanosPerCall[j];
+        }
+        out << "]}";
+    }
+    out << "\n]}\n";
+    out.precision(precision);
+}
+
+std::vector<BenchmarkSamples> readBenchmarkJson(std::istream& in) {
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    JsonCursor cursor(text);
+    std::vector<BenchmarkSamples> benchmarks;
+    cursor.expect('{');
+    if (cursor.readString() != "benchmarks") {
+        cursor.fail("expected \"benchmarks\"");
+    }
+    cursor.expect(':');
+    cursor.expect('[');
+    if (!cursor.accept(']')) {
+        do {
+            benchmarks.push_back(readBenchmark(cursor));
+        } while (cursor.accept(','));
+        cursor.expect(']');
+    }
+    cursor.expect('}');
+    cursor.expectEnd();
+    return benchmarks;
+}
+
+double sampleMedian(std::vector<double> samples) {
+    if (samples.empty()) {
+        throw std::invalid_argument("Samples can't be empty");
+    }
+    std::size_t mid = samples.size() / 2;
+    std::nth_element(samples.begin(), samples.begin() + mid, samples.end());
+    double upper = samples[mid];
+    if (samples.size() % 2 == 1) {
+        return upper;
+    }
+    double lower = *std::max_element(samples.begin(), samples.begin() + mid);
+    return (lower + upper) / 2.0;
+}
+
+double mannWhitneySlowerPValue(const std::vector<double>& before, const std::vector<double>& after) {
+    if (before.empty() || after.empty()) {
+        throw std::invalid_argument("Samples can't be empty");
+    }
+    double n1 = (double)(before.size());
+    double n2 = (double)(after.size());
+    double n = n1 + n2;
+
+    double tieTerm = 0.0;
+    double u = rankSumOfAfter(before, after, tieTerm) - n2 * (n2 + 1.0) / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+    if (variance <= 0) {
+        return 1.0;
+    }
+    // Continuity correction towards the null
+    double z = (u - n1 * n2 / 2.0 - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+RatioInterval bootstrapMedianRatio(const std::vector<double>& before, const std::vector<double>& after,
+                                   std::size_t iterations, double confidence, std::uint32_t seed) {
+    if (before.empty() || after.empty()) {
+        throw std::invalid_argument("Samples can't be empty");
+    }
+    if (iterations == 0) {
+        throw std::invalid_argument("Bootstrap iterations must be positive");
+    }
+    if (!(confidence > 0 && confidence < 1)) {
+        throw std::invalid_argument("Confidence must be between 0 and 1");
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::size_t> pickBefore(0, before.size() - 1);
+    std::uniform_int_distribution<std::size_t> pickAfter(0, after.size() - 1);
+    std::vector<double> resampledBefore(before.size());
+    std::vector<double> resampledAfter(after.size());
+    std::vector<double> ratios(iterations);
+    for (std::size_t i = 0; i < iterations; i++) {
+        for (double& x : resampledBefore) {
+            x = before[pickBefore(rng)];
+        }
+        for (double& x : resampledAfter) {
+            x = after[pickAfter(rng)];
+        }
+        ratios[i] = sampleMedian(resampledAfter) / sampleMedian(resampledBefore);
+    }
+    std::sort(ratios.begin(), ratios.end());
+
+    double tail = (1.0 - confidence) / 2.0;
+    std::size_t lowIndex = (std::size_t)(std::floor(tail * (double)(iterations - 1)));
+    std::size_t highIndex = (std::size_t)(std::ceil((1.0 - tail) * (double)(iterations - 1)));
+    return RatioInterval{ratios[lowIndex], ratios[highIndex]};
+}
+
+std::vector<BenchmarkComparison> compareBenchmarks(const std::vector<BenchmarkSamples>& before,
+                                                   const std::vector<BenchmarkSamples>& after,
+                                                   const BenchmarkCompareConfig& config) {
+    std::vector<BenchmarkComparison> comparisons;
+    for (const auto& old : before) {
+        auto current = std::find_if(after.begin(), after.end(),
+                                    [&](const BenchmarkSamples& b) { return b.name == old.name; });
+        if (current == after.end()) {
+            continue;
+        }
+        if (old.nanosPerCall.size() < 2 || current->nanosPerCall.size() < 2) {
+            throw std::invalid_argument("Benchmark " + old.name + " needs at least 2 samples per run");
+        }
+
+        BenchmarkComparison comparison;
+        comparison.name = old.name;
+        comparison.beforeMedian = sampleMedian(old.nanosPerCall);
+        comparison.afterMedian = sampleMedian(current->nanosPerCall);
+        comparison.ratio = comparison.afterMedian / comparison.beforeMedian;
+        comparison.ratioInterval = bootstrapMedianRatio(old.nanosPerCall, current->nanosPerCall,
+                                                        config.bootstrapIterations, config.confidence, config.seed);
+        comparison.pValue = mannWhitneySlowerPValue(old.nanosPerCall, current->nanosPerCall);
+        comparison.regressed = comparison.pValue < config.significance &&
+                               comparison.ratioInterval.low > config.maxSlowdown;
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Repeated timings of one benchmark, in nanoseconds per call
+struct BenchmarkSamples {
+    std::string name;
+    std::vector<double> nanosPerCall;
+};
+
+// Benchmark results as JSON:
+//     {"benchmarks": [{"name": "...", "ns_per_call": [12.5, 12.7, ...]}, ...]}
+void writeBenchmarkJson(std::ostream& out, const std::vector<BenchmarkSamples>& benchmarks);
+
+// Read what writeBenchmarkJson wrote; throws std::runtime_error on malformed input
+std::vector<BenchmarkSamples> readBenchmarkJson(std::istream& in);
+
+double sampleMedian(std::vector<double> samples);
+
+// One-sided Mann-Whitney U test of "after is slower than before", by the normal approximation
+// with tie correction. Returns the p-value; 1 when the samples can't be told apart.
+double mannWhitneySlowerPValue(const std::vector<double>& before, const std::vector<double>& after);
+
+struct RatioInterval {
+    double low;
+    double high;
+};
+
+// Percentile bootstrap confidence interval for median(after) / median(before)
+RatioInterval bootstrapMedianRatio(const std::vector<double>& before, const std::vector<double>& after,
+                                   std::size_t iterations, double confidence, std::uint32_t seed);
+
+struct BenchmarkCompareConfig {
+    double maxSlowdown = 1.10;      // median ratio a regression has to exceed
+    double significance = 0.01;     // Mann-Whitney p-value a regression has to fall below
+    double confidence = 0.99;       // bootstrap interval for the ratio
+    std::size_t bootstrapIterations = 2000;
+    std::uint32_t seed = 1;
+};
+
+struct BenchmarkComparison {
+    std::string name;
+    double beforeMedian;
+    double afterMedian;
+    double ratio;          // afterMedian / beforeMedian
+    RatioInterval ratioInterval;
+    double pValue;
+    bool regressed;        // significant, and slower than maxSlowdown even at the interval's low end
+};
+
+// Compare benchmarks present in both runs, in the order of before. Each needs at least two
+// samples per run. Single timings can't separate a slowdown from noise, so a regression needs
+// both the rank test and the bootstrap interval to agree.
+std::vector<BenchmarkComparison> compareBenchmarks(const std::vector<BenchmarkSamples>& before,
+                                                   const std::vector<BenchmarkSamples>& after,
+                                                   const BenchmarkCompareConfig& config = BenchmarkCompareConfig());
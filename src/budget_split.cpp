@@ -0,0 +1,143 @@
+#include "budget_split.h"
+#include "funds_calculator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+struct ProjectBurn {
+    double hourlyRate;
+    double dailyStorageCost;
+    double capLevel;  // level at which the project reaches its target; infinity if it has none
+    bool active;      // false when the project costs nothing to run
+};
+
+// Funds for which calculateFundsDuration returns exactly hours
+double fundsForRunway(const ProjectBurn& project, double hours) {
+    if (project.hourlyRate <= 0) {
+        return project.dailyStorageCost * hours / 24.0;
+    }
+    return project.hourlyRate * hours + project.dailyStorageCost * std::ceil(hours / 24.0);
+}
+
+double runwayAtLevel(const RunwayTarget& target, double level) {
+    double hours = target.weight * level;
+    return target.targetHours >= 0 ? std::min(target.targetHours, hours) : hours;
+}
+
+double fundsAtLevel(const std::vector<ProjectBurn>& burns, const std::vector<RunwayTarget>& targets, double level) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < burns.size(); i++) {
+        if (burns[i].active) {
+            total += fundsForRunway(burns[i], runwayAtLevel(targets[i], level));
+        }
+    }
+    return total;
+}
+
+} // namespace
+
+BudgetSplit splitBudgetEqualRunway(double initialFunds, const std::vector<std::vector<GpuModel>>& projects) {
+    return splitBudgetForTargets(initialFunds, projects, std::vector<RunwayTarget>(projects.size()));
+}
+
+BudgetSplit splitBudgetForTargets(double initialFunds, const std::vector<std::vector<GpuModel>>& projects,
+                                  const std::vector<RunwayTarget>& targets) {
+    // Input validation
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (projects.empty()) {
+        throw std::invalid_argument("Projects list can't be empty");
+    }
+    if (targets.size() != projects.size()) {
+        throw std::invalid_argument("Runway targets must match the projects");
+    }
+
+    const double unbounded = std::numeric_limits<double>::infinity();
+    std::vector<ProjectBurn> burns(projects.size());
+    std::vector<double> capLevels;
+    bool anyUncapped = false;
+    for (std::size_t i = 0; i < projects.size(); i++) {
+        if (projects[i].empty()) {
+            throw std::invalid_argument("GPU models list can't be empty");
+        }
+        if (!(targets[i].weight > 0)) {
+            throw std::invalid_argument("Runway weight must be positive");
+        }
+        ProjectBurn& burn = burns[i];
+        burn.hourlyRate = 0.0;
+        burn.dailyStorageCost = 0.0;
+        for (const auto& gpu : projects[i]) {
+            detail::validateFleetRow(gpu);
+            burn.hourlyRate += gpu.getHourlyRate() * gpu.getNumInstances();
+            burn.dailyStorageCost += gpu.getDailyStorageCost() * gpu.getNumInstances();
+        }
+        burn.active = burn.hourlyRate > 0 || burn.dailyStorageCost > 0;
+        burn.capLevel = targets[i].targetHours >= 0 ? targets[i].targetHours / targets[i].weight : unbounded;
+        if (burn.active) {
+            if (burn.capLevel < unbounded) {
+                capLevels.push_back(burn.capLevel);
+            } else {
+                anyUncapped = true;
+            }
+        }
+    }
+    std::sort(capLevels.begin(), capLevels.end());
+
+    // Bracket the level: lo is affordable, hi is not (or every target is met at lo)
+    double lo = 0.0;
+    double hi = unbounded;
+    std::size_t first = 0;
+    std::size_t last = capLevels.size();
+    while (first < last) {
+        std::size_t mid = first + (last - first) / 2;
+        if (fundsAtLevel(burns, targets, capLevels[mid]) <= initialFunds) {
+            lo = capLevels[mid];
+            first = mid + 1;
+        } else {
+            hi = capLevels[mid];
+            last = mid;
+        }
+    }
+    if (hi == unbounded && anyUncapped) {
+        hi = std::max(1.0, 2.0 * lo);
+        while (fundsAtLevel(burns, targets, hi) <= initialFunds) {
+            lo = hi;
+            hi *= 2.0;
+        }
+    }
+
+    // Funds are a nondecreasing step-plus-linear function of the level, so bisect to the last
+    // representable affordable level
+    if (hi < unbounded) {
+        while (true) {
+            double mid = lo + (hi - lo) / 2.0;
+            if (mid <= lo || mid >= hi) {
+                break;
+            }
+            if (fundsAtLevel(burns, targets, mid) <= initialFunds) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+    }
+
+    BudgetSplit split;
+    split.funds.assign(projects.size(), 0.0);
+    split.runwayHours.assign(projects.size(), -1);
+    double allocated = 0.0;
+    for (std::size_t i = 0; i < projects.size(); i++) {
+        if (!burns[i].active) {
+            continue;
+        }
+        split.runwayHours[i] = runwayAtLevel(targets[i], lo);
+        split.funds[i] = fundsForRunway(burns[i], split.runwayHours[i]);
+        allocated += split.funds[i];
+    }
+    split.unallocated = std::max(0.0, initialFunds - allocated);
+    return split;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <vector>
+
+// Side table entry for one project: runway is shared out in proportion to weight, and a
+// project stops receiving funds once it reaches targetHours (-1 for no target)
+struct RunwayTarget {
+    double targetHours = -1;
+    double weight = 1.0;
+};
+
+struct BudgetSplit {
+    std::vector<double> funds;        // per project in input order
+    std::vector<double> runwayHours;  // calculateFundsDurationMultipleGpus of each share; -1 if it costs nothing
+    double unallocated;               // left over once every project meets its target, or that can't
+                                      // buy anyone's next day of storage
+};
+
+// Split one pool of funds across projects so that every project gets the same runway.
+BudgetSplit splitBudgetEqualRunway(double initialFunds, const std::vector<std::vector<GpuModel>>& projects);
+
+// Water-filling split: find the largest level L such that giving each project the runway
+// min(targetHours, weight * L) fits in initialFunds. targets[i] applies to projects[i].
+//
+// Funds needed for a runway of T hours are rate * T + storage * ceil(T / 24), the exact inverse
+// of calculateFundsDuration (storage-only fleets amortise storage, as that function does).
+// The levels at which projects hit their targets are sorted and binary-searched for the
+// stretch containing the answer, then the level is bisected to full precision within it, so
+// the cost is O(n log n) plus a fixed number of O(n) passes, with no trial runway calls.
+BudgetSplit splitBudgetForTargets(double initialFunds, const std::vector<std::vector<GpuModel>>& projects,
+                                  const std::vector<RunwayTarget>& targets);
@@ -0,0 +1,166 @@
+#include "bulk_pipeline.h"
+#include "fleet_csv.h"
+#include "funds_calculator.h"
+#include "spsc_ring.h"
+#include "trace.h"
+#include <chrono>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct PipelineRow {
+    std::size_t lineNumber;
+    GpuModel gpu;
+    bool valid;
+    std::string error;
+    double totalCost;
+};
+
+using Batch = std::vector<PipelineRow>;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Push into ring and charge the time spent blocked to counters
+void pushTimed(SpscRing<Batch>& ring, Batch batch, StageCounters& counters) {
+    Clock::time_point start = Clock::now();
+    ring.push(std::move(batch));
+    counters.waitSeconds += secondsSince(start);
+}
+
+bool popTimed(SpscRing<Batch>& ring, Batch& batch, StageCounters& counters) {
+    Clock::time_point start = Clock::now();
+    bool more = ring.pop(batch);
+    counters.waitSeconds += secondsSince(start);
+    return more;
+}
+
+void parseStage(std::istream& input, SpscRing<Batch>& out, std::size_t batchSize, StageCounters& counters) {
+    TRACE_SCOPE("parse stage");
+    std::string line;
+    std::size_t lineNumber = 0;
+    Batch batch;
+    batch.reserve(batchSize);
+
+    Clock::time_point start = Clock::now();
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#' || line == "\r" || (lineNumber == 1 && line.rfind("name,", 0) == 0)) {
+            continue;
+        }
+
+        PipelineRow row{lineNumber, GpuModel(), false, std::string(), 0.0};
+        row.valid = parseFleetCsvRow(line, row.gpu, row.error);
+        batch.push_back(std::move(row));
+        counters.items++;
+
+        if (batch.size() == batchSize) {
+            counters.busySeconds += secondsSince(start);
+            counters.batches++;
+            pushTimed(out, std::move(batch), counters);
+            batch = Batch();
+            batch.reserve(batchSize);
+            start = Clock::now();
+        }
+    }
+    counters.busySeconds += secondsSince(start);
+
+    if (!batch.empty()) {
+        counters.batches++;
+        pushTimed(out, std::move(batch), counters);
+    }
+    out.close();
+}
+
+void priceStage(SpscRing<Batch>& in, SpscRing<Batch>& out, int runningHours, StageCounters& counters) {
+    Batch batch;
+    while (popTimed(in, batch, counters)) {
+        TRACE_SCOPE("price batch");
+        Clock::time_point start = Clock::now();
+        for (auto& row : batch) {
+            if (row.valid) {
+                row.totalCost = calculateTotalCost(row.gpu.getHourlyRate(), row.gpu.getNumInstances(),
+                                                   runningHours, row.gpu.getDailyStorageCost());
+            }
+        }
+        counters.items += batch.size();
+        counters.batches++;
+        counters.busySeconds += secondsSince(start);
+        pushTimed(out, std::move(batch), counters);
+    }
+    out.close();
+}
+
+void formatStage(SpscRing<Batch>& in, std::ostream& output, std::ostream& errors,
+                 StageCounters& counters, std::size_t& errorRows) {
+    Batch batch;
+    std::string text;
+    std::string errorText;
+    char number[64];
+
+    while (popTimed(in, batch, counters)) {
+        TRACE_SCOPE("format batch");
+        Clock::time_point start = Clock::now();
+        text.clear();
+        errorText.clear();
+        for (const auto& row : batch) {
+            if (row.valid) {
+                std::snprintf(number, sizeof(number), ",%d,%.2f\n", row.gpu.getNumInstances(), row.totalCost);
+                text += row.gpu.getName();
+                text += number;
+            } else {
+                errorText += "line " + std::to_string(row.lineNumber) + ": " + row.error + "\n";
+                errorRows++;
+            }
+        }
+        output.write(text.data(), (std::streamsize)(text.size()));
+        errors.write(errorText.data(), (std::streamsize)(errorText.size()));
+        counters.items += batch.size();
+        counters.batches++;
+        counters.busySeconds += secondsSince(start);
+    }
+    output.flush();
+}
+
+} // namespace
+
+double StageCounters::itemsPerSecond() const {
+    return busySeconds > 0 ? (double)(items) / busySeconds : 0.0;
+}
+
+PipelineStats runBulkPipeline(std::istream& input, std::ostream& output, std::ostream& errors,
+                              const PipelineConfig& config) {
+    // Input validation
+    if (config.runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (config.queueDepth == 0) {
+        throw std::invalid_argument("Queue depth must be positive");
+    }
+    if (config.batchSize == 0) {
+        throw std::invalid_argument("Batch size must be positive");
+    }
+
+    PipelineStats stats;
+    SpscRing<Batch> parsed(config.queueDepth);
+    SpscRing<Batch> priced(config.queueDepth);
+
+    Clock::time_point start = Clock::now();
+    std::thread parser(parseStage, std::ref(input), std::ref(parsed), config.batchSize, std::ref(stats.parse));
+    std::thread pricer(priceStage, std::ref(parsed), std::ref(priced), config.runningHours, std::ref(stats.price));
+    formatStage(priced, output, errors, stats.format, stats.errorRows);
+    parser.join();
+    pricer.join();
+    stats.wallSeconds = secondsSince(start);
+
+    return stats;
+}
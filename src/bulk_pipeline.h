@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+
+struct PipelineConfig {
+    int runningHours = 0;
+    std::size_t queueDepth = 64;   // batches buffered between two stages
+    std::size_t batchSize = 1024;  // rows per batch
+};
+
+// Throughput counters for one pipeline stage
+struct StageCounters {
+    std::size_t items = 0;
+    std::size_t batches = 0;
+    double busySeconds = 0.0;  // time spent doing the stage's own work
+    double waitSeconds = 0.0;  // time blocked on the neighbouring rings
+
+    double itemsPerSecond() const;
+};
+
+struct PipelineStats {
+    StageCounters parse;
+    StageCounters price;
+    StageCounters format;
+    std::size_t errorRows = 0;
+    double wallSeconds = 0.0;
+};
+
+// Price a fleet CSV (see parseFleetCsvRow) for config.runningHours hours.
+// Parsing, pricing and formatting run on three threads joined by bounded SPSC rings, so
+// reading input, the calculator maths and writing output overlap. Each valid row produces
+//     name,numInstances,totalCost
+// on output; invalid rows produce "line N: message" on errors. Output order matches input order.
+// Blank lines, '#' comments and a leading "name,..." header line are skipped.
+PipelineStats runBulkPipeline(std::istream& input, std::ostream& output, std::ostream& errors,
+                              const PipelineConfig& config);
@@ -0,0 +1,168 @@
+#include "burn_rate_estimator.h"
+#include "funds_calculator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+const std::size_t BurnRateEstimator::WINDOW;
+
+namespace {
+
+double runwayAt(double remainingFunds, double rate) {
+    if (remainingFunds <= 0) {
+        return 0.0;
+    }
+    return rate > 0 ? remainingFunds / rate : -1;
+}
+
+} // namespace
+
+BurnRateEstimator::BurnRateEstimator(double halfLifeHours, double bucketHours) : bucketHours(bucketHours) {
+    if (halfLifeHours <= 0) {
+        throw std::invalid_argument("Half-life must be positive");
+    }
+    if (bucketHours <= 0) {
+        throw std::invalid_argument("Bucket width must be positive");
+    }
+    alpha = 1.0 - std::pow(0.5, bucketHours / halfLifeHours);
+}
+
+void BurnRateEstimator::observe(double timestampHours, double amount) {
+    if (!std::isfinite(timestampHours)) {
+        throw std::invalid_argument("Timestamp must be finite");
+    }
+    if (!std::isfinite(amount)) {
+        throw std::invalid_argument("Charge must be finite");
+    }
+    if (amount < 0) {
+        throw std::invalid_argument("Charge can't be negative");
+    }
+    if (!started) {
+        started = true;
+        bucketStart = std::floor(timestampHours / bucketHours) * bucketHours;
+    }
+    advanceTo(timestampHours);
+    bucketAmount += amount;
+}
+
+void BurnRateEstimator::advanceTo(double timestampHours) {
+    if (!std::isfinite(timestampHours)) {
+        throw std::invalid_argument("Timestamp must be finite");
+    }
+    if (!started || timestampHours < bucketStart + bucketHours) {
+        return;
+    }
+
+    closeBucket(bucketAmount / bucketHours);
+    bucketAmount = 0.0;
+    bucketStart += bucketHours;
+
+    // Idle buckets are zero-rate samples. Past one window's worth they no longer change the
+    // quantiles, so the rest are folded into the moving average in closed form.
+    double idle = std::floor((timestampHours - bucketStart) / bucketHours);
+    std::size_t replay = (std::size_t)(std::min(idle, (double)(WINDOW)));
+    for (std::size_t i = 0; i < replay; i++) {
+        closeBucket(0.0);
+    }
+    if (idle > (double)(replay)) {
+        // k zero samples: mean *= (1-a)^k, variance = (1-a)^k * (variance + mean^2 * (1 - (1-a)^k))
+        double keep = std::pow(1.0 - alpha, idle - (double)(replay));
+        ewmaVariance = keep * (ewmaVariance + ewmaRate * ewmaRate * (1.0 - keep));
+        ewmaRate *= keep;
+        // Saturate rather than convert a gap of more than SIZE_MAX buckets
+        std::size_t room = std::numeric_limits<std::size_t>::max() - sampleCount;
+        double skipped = idle - (double)(replay);
+        sampleCount += skipped >= (double)(room) ? room : (std::size_t)(skipped);
+    }
+    bucketStart += idle * bucketHours;
+}
+
+void BurnRateEstimator::closeBucket(double rate) {
+    if (sampleCount == 0) {
+        ewmaRate = rate;
+        ewmaVariance = 0.0;
+    } else {
+        double delta = rate - ewmaRate;
+        ewmaRate += alpha * delta;
+        ewmaVariance = (1.0 - alpha) * (ewmaVariance + alpha * delta * delta);
+    }
+    recent[recentNext] = rate;
+    recentNext = (recentNext + 1) % WINDOW;
+    sampleCount++;
+}
+
+bool BurnRateEstimator::hasHistory() const {
+    return sampleCount > 0;
+}
+
+std::size_t BurnRateEstimator::getSampleCount() const {
+    return sampleCount;
+}
+
+double BurnRateEstimator::getEwmaRate() const {
+    return ewmaRate;
+}
+
+double BurnRateEstimator::getRateStdDev() const {
+    return std::sqrt(ewmaVariance);
+}
+
+double BurnRateEstimator::getQuantileRate(double q) const {
+    if (q < 0 || q > 1) {
+        throw std::invalid_argument("Quantile must be between 0 and 1");
+    }
+    std::size_t count = std::min(sampleCount, WINDOW);
+    if (count == 0) {
+        return 0.0;
+    }
+
+    std::array<double, WINDOW> sorted;
+    std::copy(recent.begin(), recent.begin() + count, sorted.begin());
+    std::size_t rank = (std::size_t)(std::llround(q * (double)(count - 1)));
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + count);
+    return sorted[rank];
+}
+
+RunwayForecast BurnRateEstimator::forecast(double remainingFunds, double hourlyRate, int numInstances,
+                                           double dailyStorageCost) const {
+    if (!hasHistory()) {
+        double nominal = calculateFundsDuration(std::max(0.0, remainingFunds), hourlyRate, numInstances,
+                                                dailyStorageCost);
+        return RunwayForecast{nominal, nominal, nominal, false};
+    }
+
+    return RunwayForecast{runwayAt(remainingFunds, ewmaRate),
+                          runwayAt(remainingFunds, getQuantileRate(0.9)),
+                          runwayAt(remainingFunds, getQuantileRate(0.1)),
+                          true};
+}
+
+WalletBurnTracker::WalletBurnTracker(std::size_t walletCount, double halfLifeHours, double bucketHours)
+    : wallets(walletCount, BurnRateEstimator(halfLifeHours, bucketHours)) {
+}
+
+void WalletBurnTracker::observe(std::uint32_t walletId, double timestampHours, double amount) {
+    if (walletId >= wallets.size()) {
+        throw std::out_of_range("Unknown wallet id");
+    }
+    wallets[walletId].observe(timestampHours, amount);
+}
+
+void WalletBurnTracker::observeBatch(const std::uint32_t* walletIds, const double* timestampsHours,
+                                     const double* amounts, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        observe(walletIds[i], timestampsHours[i], amounts[i]);
+    }
+}
+
+const BurnRateEstimator& WalletBurnTracker::getWallet(std::uint32_t walletId) const {
+    if (walletId >= wallets.size()) {
+        throw std::out_of_range("Unknown wallet id");
+    }
+    return wallets[walletId];
+}
+
+std::size_t WalletBurnTracker::size() const {
+    return wallets.size();
+}
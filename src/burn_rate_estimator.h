@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Runway in hours; -1 means the funds last indefinitely, matching calculateFundsDuration
+struct RunwayForecast {
+    double expectedHours;
+    double lowHours;    // runway if spend runs at the high (90th percentile) recent rate
+    double highHours;   // runway if spend runs at the low (10th percentile) recent rate
+    bool fromObservedSpend;
+};
+
+// Online burn-rate estimate for one wallet.
+// Charge events are summed into fixed-width time buckets; each closed bucket contributes one
+// $/hour sample to an exponentially weighted mean and variance and to a ring of the most recent
+// WINDOW samples used for quantiles. Memory is fixed per wallet and observe() is O(1).
+class BurnRateEstimator {
+public:
+    static const std::size_t WINDOW = 64;
+
+    /**
+     * @param halfLifeHours Age at which a sample's weight in the moving average halves
+     * @param bucketHours Width of the time buckets events are summed into
+     */
+    explicit BurnRateEstimator(double halfLifeHours = 24.0, double bucketHours = 1.0);
+
+    // Record a charge of amount dollars at timestampHours. Events older than the open bucket
+    // are counted in the open bucket.
+    void observe(double timestampHours, double amount);
+
+    // Close every bucket that ends at or before timestampHours (e.g. to account for idle time)
+    void advanceTo(double timestampHours);
+
+    bool hasHistory() const;
+    std::size_t getSampleCount() const;
+    double getEwmaRate() const;
+    double getRateStdDev() const;
+    // q-quantile (0..1) of the last WINDOW bucket rates
+    double getQuantileRate(double q) const;
+
+    // Runway for remainingFunds from observed spend, or from the nominal calculator
+    // (calculateFundsDuration with the given configuration) while there is no history yet
+    RunwayForecast forecast(double remainingFunds, double hourlyRate, int numInstances,
+                            double dailyStorageCost) const;
+
+private:
+    void closeBucket(double rate);
+
+    double bucketHours;
+    double alpha;
+    bool started = false;
+    double bucketStart = 0.0;
+    double bucketAmount = 0.0;
+
+    std::size_t sampleCount = 0;
+    double ewmaRate = 0.0;
+    double ewmaVariance = 0.0;
+    std::array<double, WINDOW> recent{};
+    std::size_t recentNext = 0;
+};
+
+// Estimators for many wallets, indexed by a dense wallet id
+class WalletBurnTracker {
+public:
+    WalletBurnTracker(std::size_t walletCount, double halfLifeHours = 24.0, double bucketHours = 1.0);
+
+    void observe(std::uint32_t walletId, double timestampHours, double amount);
+    void observeBatch(const std::uint32_t* walletIds, const double* timestampsHours, const double* amounts,
+                      std::size_t count);
+
+    const BurnRateEstimator& getWallet(std::uint32_t walletId) const;
+    std::size_t size() const;
+
+private:
+    std::vector<BurnRateEstimator> wallets;
+};
@@ -0,0 +1,326 @@
+#include "columnar_results.h"
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File layout: header, the blocks (each column's bytes back to back), the name dictionary
+// (count, then length-prefixed names), the block index aligned to 8, then the footer.
+// A block index entry is the block's row count followed by offset and size of each column.
+struct ColumnarHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t byteOrderMark;
+};
+
+struct ColumnarFooter {
+    std::uint64_t dictionaryOffset;
+    std::uint64_t dictionarySize;
+    std::uint64_t indexOffset;
+    std::uint64_t blockCount;
+    std::uint64_t rowCount;
+    char magic[8];
+};
+
+namespace {
+
+const char COLUMNAR_MAGIC[8] = {'V', 'G', 'P', 'U', 'C', 'O', 'L', 'S'};
+const std::uint64_t BYTE_ORDER_MARK = 0x0102030405060708ULL;
+const std::size_t INDEX_ENTRY_WORDS = 1 + 2 * RESULT_COLUMN_COUNT;
+
+std::runtime_error columnarError(const std::string& path, const std::string& message) {
+    return std::runtime_error("Result file " + path + ": " + message);
+}
+
+void putVarint(std::vector<unsigned char>& out, std::int64_t value) {
+    std::uint64_t zigzag = ((std::uint64_t)(value) << 1) ^ (std::uint64_t)(value >> 63);
+    while (zigzag >= 0x80) {
+        out.push_back((unsigned char)(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    out.push_back((unsigned char)(zigzag));
+}
+
+// Returns false if the varint runs past end or is longer than 10 bytes
+bool getVarint(const unsigned char*& pos, const unsigned char* end, std::int64_t& value) {
+    std::uint64_t zigzag = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos == end) {
+            return false;
+        }
+        unsigned char byte = *pos++;
+        zigzag |= (std::uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            value = (std::int64_t)(zigzag >> 1) ^ -(std::int64_t)(zigzag & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+ColumnarResultWriter::ColumnarResultWriter(const std::string& path, std::size_t rowsPerBlock)
+    : path(path), tempPath(path + ".tmp"), rowsPerBlock(rowsPerBlock == 0 ? 1 : rowsPerBlock) {
+    out.open(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw columnarError(tempPath, "can't open for writing");
+    }
+
+    ColumnarHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, COLUMNAR_MAGIC, sizeof(header.magic));
+    header.version = COLUMNAR_FORMAT_VERSION;
+    header.headerSize = sizeof(ColumnarHeader);
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fileOffset = sizeof(header);
+}
+
+ColumnarResultWriter::~ColumnarResultWriter() {
+    if (!closed) {
+        out.close();
+        std::remove(tempPath.c_str());
+    }
+}
+
+void ColumnarResultWriter::append(std::string_view modelName, int numInstances, int runningHours, double totalCost) {
+    if (closed) {
+        throw columnarError(path, "append after close");
+    }
+    std::int64_t row[RESULT_COLUMN_COUNT] = {
+        (std::int64_t)(names.intern(modelName)),
+        numInstances,
+        runningHours,
+        std::llround(totalCost * 100.0),
+    };
+    for (std::size_t c = 0; c < RESULT_COLUMN_COUNT; c++) {
+        putVarint(encoded[c], row[c] - previous[c]);
+        previous[c] = row[c];
+    }
+    blockRows++;
+    rowCount++;
+    if (blockRows == rowsPerBlock) {
+        flushBlock();
+    }
+}
+
+void ColumnarResultWriter::flushBlock() {
+    if (blockRows == 0) {
+        return;
+    }
+    index.push_back(blockRows);
+    for (std::size_t c = 0; c < RESULT_COLUMN_COUNT; c++) {
+        index.push_back(fileOffset);
+        index.push_back(encoded[c].size());
+        out.write(reinterpret_cast<const char*>(encoded[c].data()), (std::streamsize)(encoded[c].size()));
+        fileOffset += encoded[c].size();
+        encoded[c].clear();
+        previous[c] = 0;  // every block decodes on its own
+    }
+    blockRows = 0;
+}
+
+void ColumnarResultWriter::close() {
+    if (closed) {
+        return;
+    }
+    flushBlock();
+
+    ColumnarFooter footer;
+    std::memset(&footer, 0, sizeof(footer));
+    footer.dictionaryOffset = fileOffset;
+    std::uint64_t nameCount = names.size();
+    out.write(reinterpret_cast<const char*>(&nameCount), sizeof(nameCount));
+    fileOffset += sizeof(nameCount);
+    for (std::uint32_t id = 0; id < names.size(); id++) {
+        const std::string& name = names.nameOf(id);
+        std::uint32_t nameLength = (std::uint32_t)(name.size());
+        out.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        out.write(name.data(), (std::streamsize)(name.size()));
+        fileOffset += sizeof(nameLength) + name.size();
+    }
+    footer.dictionarySize = fileOffset - footer.dictionaryOffset;
+
+    const char padding[8] = {0};
+    std::uint64_t aligned = (fileOffset + 7) & ~(std::uint64_t)(7);
+    out.write(padding, (std::streamsize)(aligned - fileOffset));
+    footer.indexOffset = aligned;
+    footer.blockCount = index.size() / INDEX_ENTRY_WORDS;
+    footer.rowCount = rowCount;
+    std::memcpy(footer.magic, COLUMNAR_MAGIC, sizeof(footer.magic));
+    out.write(reinterpret_cast<const char*>(index.data()), (std::streamsize)(index.size() * sizeof(std::uint64_t)));
+    out.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    out.flush();
+    if (!out) {
+        throw columnarError(tempPath, "write failed");
+    }
+    out.close();
+    closed = true;
+
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        throw columnarError(path, std::strerror(errno));
+    }
+}
+
+std::size_t ColumnarResultWriter::getRowCount() const {
+    return rowCount;
+}
+
+ColumnarResultReader::ColumnarResultReader(const std::string& path) : path(path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw columnarError(path, std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw columnarError(path, std::strerror(error));
+    }
+    length = (std::size_t)(info.st_size);
+    if (length < sizeof(ColumnarHeader) + sizeof(ColumnarFooter)) {
+        ::close(fd);
+        throw columnarError(path, "file is too small");
+    }
+
+    void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw columnarError(path, std::strerror(errno));
+    }
+    data = static_cast<const unsigned char*>(mapped);
+
+    try {
+        ColumnarHeader header;
+        ColumnarFooter footer;
+        std::memcpy(&header, data, sizeof(header));
+        std::memcpy(&footer, data + length - sizeof(footer), sizeof(footer));
+        if (std::memcmp(header.magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) != 0
+            || std::memcmp(footer.magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) != 0) {
+            throw columnarError(path, "not a columnar result file");
+        }
+        if (header.byteOrderMark != BYTE_ORDER_MARK) {
+            throw columnarError(path, "written on a machine with a different byte order");
+        }
+        if (header.version != COLUMNAR_FORMAT_VERSION || header.headerSize != sizeof(ColumnarHeader)) {
+            throw columnarError(path, "unsupported format version " + std::to_string(header.version));
+        }
+
+        std::size_t indexLimit = length - sizeof(ColumnarFooter);
+        std::size_t entryBytes = INDEX_ENTRY_WORDS * sizeof(std::uint64_t);
+        if (footer.indexOffset % 8 != 0 || footer.indexOffset > indexLimit
+            || footer.blockCount > (indexLimit - footer.indexOffset) / entryBytes
+            || footer.dictionaryOffset > indexLimit || footer.dictionarySize > indexLimit - footer.dictionaryOffset) {
+            throw columnarError(path, "truncated or corrupt");
+        }
+        index = reinterpret_cast<const std::uint64_t*>(data + footer.indexOffset);
+        blockCount = footer.blockCount;
+        rowCount = footer.rowCount;
+
+        std::uint64_t rowsInBlocks = 0;
+        for (std::size_t b = 0; b < blockCount; b++) {
+            const std::uint64_t* entry = blockEntry(b);
+            rowsInBlocks += entry[0];
+            for (std::size_t c = 0; c < RESULT_COLUMN_COUNT; c++) {
+                std::uint64_t offset = entry[1 + 2 * c];
+                std::uint64_t size = entry[2 + 2 * c];
+                // Every row takes at least one byte in every column
+                if (offset > footer.dictionaryOffset || size > footer.dictionaryOffset - offset || entry[0] > size) {
+                    throw columnarError(path, "truncated or corrupt");
+                }
+            }
+        }
+        if (rowsInBlocks != rowCount) {
+            throw columnarError(path, "truncated or corrupt");
+        }
+
+        const unsigned char* pos = data + footer.dictionaryOffset;
+        const unsigned char* end = pos + footer.dictionarySize;
+        std::uint64_t nameCount = 0;
+        if ((std::size_t)(end - pos) < sizeof(nameCount)) {
+            throw columnarError(path, "truncated or corrupt");
+        }
+        std::memcpy(&nameCount, pos, sizeof(nameCount));
+        pos += sizeof(nameCount);
+        for (std::uint64_t i = 0; i < nameCount; i++) {
+            std::uint32_t nameLength = 0;
+            if ((std::size_t)(end - pos) < sizeof(nameLength)) {
+                throw columnarError(path, "truncated or corrupt");
+            }
+            std::memcpy(&nameLength, pos, sizeof(nameLength));
+            pos += sizeof(nameLength);
+            if ((std::size_t)(end - pos) < nameLength) {
+                throw columnarError(path, "truncated or corrupt");
+            }
+            modelNames.emplace_back(reinterpret_cast<const char*>(pos), nameLength);
+            pos += nameLength;
+        }
+    } catch (...) {
+        ::munmap(const_cast<unsigned char*>(data), length);
+        throw;
+    }
+}
+
+ColumnarResultReader::~ColumnarResultReader() {
+    ::munmap(const_cast<unsigned char*>(data), length);
+}
+
+const std::uint64_t* ColumnarResultReader::blockEntry(std::size_t block) const {
+    if (block >= blockCount) {
+        throw std::out_of_range("Result block index out of range");
+    }
+    return index + block * INDEX_ENTRY_WORDS;
+}
+
+std::size_t ColumnarResultReader::getRowCount() const {
+    return rowCount;
+}
+
+std::size_t ColumnarResultReader::getBlockCount() const {
+    return blockCount;
+}
+
+std::size_t ColumnarResultReader::getBlockRowCount(std::size_t block) const {
+    return blockEntry(block)[0];
+}
+
+const std::vector<std::string_view>& ColumnarResultReader::getModelNames() const {
+    return modelNames;
+}
+
+void ColumnarResultReader::readBlock(ResultColumn column, std::size_t block, std::vector<std::int64_t>& values) const {
+    const std::uint64_t* entry = blockEntry(block);
+    std::size_t c = (std::size_t)(column);
+    const unsigned char* pos = data + entry[1 + 2 * c];
+    const unsigned char* end = pos + entry[2 + 2 * c];
+
+    values.resize(entry[0]);
+    std::int64_t value = 0;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        std::int64_t delta;
+        if (!getVarint(pos, end, delta)) {
+            throw columnarError(path, "truncated or corrupt");
+        }
+        value = (std::int64_t)((std::uint64_t)(value) + (std::uint64_t)(delta));
+        values[i] = value;
+    }
+}
+
+std::vector<std::int64_t> ColumnarResultReader::readColumn(ResultColumn column) const {
+    std::vector<std::int64_t> values;
+    values.reserve(rowCount);
+    std::vector<std::int64_t> block;
+    for (std::size_t b = 0; b < blockCount; b++) {
+        readBlock(column, b, block);
+        values.insert(values.end(), block.begin(), block.end());
+    }
+    return values;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "string_interner.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Columns of a result file. Costs are stored as integer cents, model names as ids into the
+// file's name dictionary.
+enum class ResultColumn { ModelName, NumInstances, RunningHours, TotalCostCents };
+
+const std::size_t RESULT_COLUMN_COUNT = 4;
+const std::uint32_t COLUMNAR_FORMAT_VERSION = 1;
+
+// Writes sweep/account results as a columnar binary file.
+// Rows are grouped into blocks; within a block each column is stored as zigzag varints of
+// the difference from the previous row, so runs of similar costs take a byte or two per row.
+// Model names are dictionary encoded. A block index and footer at the end of the file let a
+// reader decode any single column of any block. The file is written next to path and renamed
+// into place by close(). Throws std::runtime_error on I/O failure.
+class ColumnarResultWriter {
+public:
+    /**
+     * @param path Output file
+     * @param rowsPerBlock Rows per block; larger blocks compress slightly better, smaller ones
+     *                     let readers skip more finely
+     */
+    explicit ColumnarResultWriter(const std::string& path, std::size_t rowsPerBlock = 65536);
+    ~ColumnarResultWriter();
+
+    ColumnarResultWriter(const ColumnarResultWriter&) = delete;
+    ColumnarResultWriter& operator=(const ColumnarResultWriter&) = delete;
+
+    // totalCost is rounded to cents, as calculateTotalCost already does
+    void append(std::string_view modelName, int numInstances, int runningHours, double totalCost);
+
+    // Flush the last block, write the dictionary, index and footer, and rename into place
+    void close();
+
+    std::size_t getRowCount() const;
+
+private:
+    void flushBlock();
+
+    std::string path;
+    std::string tempPath;
+    std::ofstream out;
+    std::size_t rowsPerBlock;
+    bool closed = false;
+
+    StringInterner names;
+    std::int64_t previous[RESULT_COLUMN_COUNT] = {0, 0, 0, 0};
+    std::vector<unsigned char> encoded[RESULT_COLUMN_COUNT];
+    std::size_t blockRows = 0;
+    std::size_t rowCount = 0;
+    std::uint64_t fileOffset = 0;
+    std::vector<std::uint64_t> index;
+};
+
+// Read-only view of a columnar result file mapped into memory. Opening checks the magic,
+// version, byte order and that the index and dictionary lie inside the file, and throws
+// std::runtime_error otherwise. Columns are decoded on demand, one block at a time.
+class ColumnarResultReader {
+public:
+    explicit ColumnarResultReader(const std::string& path);
+    ~ColumnarResultReader();
+
+    ColumnarResultReader(const ColumnarResultReader&) = delete;
+    ColumnarResultReader& operator=(const ColumnarResultReader&) = delete;
+
+    std::size_t getRowCount() const;
+    std::size_t getBlockCount() const;
+    std::size_t getBlockRowCount(std::size_t block) const;
+
+    // Model names in id order; the ModelName column holds indices into this list
+    const std::vector<std::string_view>& getModelNames() const;
+
+    // Decode one column of one block, replacing the contents of values
+    void readBlock(ResultColumn column, std::size_t block, std::vector<std::int64_t>& values) const;
+
+    // Decode a whole column
+    std::vector<std::int64_t> readColumn(ResultColumn column) const;
+
+private:
+    const std::uint64_t* blockEntry(std::size_t block) const;
+
+    std::string path;
+    const unsigned char* data = nullptr;
+    std::size_t length = 0;
+    const std::uint64_t* index = nullptr;
+    std::size_t blockCount = 0;
+    std::size_t rowCount = 0;
+    std::vector<std::string_view> modelNames;
+};
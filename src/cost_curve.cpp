@@ -0,0 +1,73 @@
+#include "cost_curve.h"
+#include "funds_calculator.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+void validateCurve(int horizonHours, int strideHours) {
+    if (horizonHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (strideHours <= 0) {
+        throw std::invalid_argument("Stride must be positive");
+    }
+}
+
+} // namespace
+
+CostCurve::CostCurve(const std::vector<GpuModel>& gpuModels) {
+    // Input validation
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    for (const auto& gpu : gpuModels) {
+        detail::validateFleetRow(gpu);
+        double instances = (double)(gpu.getNumInstances());
+        hourlyRate += gpu.getHourlyRate() * instances;
+        dailyStorageCost += gpu.getDailyStorageCost() * instances;
+    }
+}
+
+double CostCurve::getHourlyRate() const {
+    return hourlyRate;
+}
+
+double CostCurve::getDailyStorageCost() const {
+    return dailyStorageCost;
+}
+
+double CostCurve::costAt(int runningHours) const {
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    double cost = hourlyRate * (double)(runningHours) + dailyStorageCost * (double)(calculateRunningDays(runningHours));
+    return std::round(cost * 100.0) / 100.0;
+}
+
+std::size_t CostCurve::pointCount(int horizonHours, int strideHours) {
+    validateCurve(horizonHours, strideHours);
+    std::size_t strides = (std::size_t)(horizonHours / strideHours);
+    return strides + 1 + (horizonHours % strideHours != 0 ? 1 : 0);
+}
+
+std::size_t CostCurve::fill(double initialFunds, int horizonHours, int strideHours, int* hours,
+                            double* cumulativeCost, double* remainingFunds) const {
+    std::size_t count = pointCount(horizonHours, strideHours);
+
+    // The fleet was summed once in the constructor, so each point is one multiply-add
+    for (std::size_t i = 0; i < count; i++) {
+        int hour = i == count - 1 ? horizonHours : (int)(i) * strideHours;
+        double cost = costAt(hour);
+        if (hours) {
+            hours[i] = hour;
+        }
+        if (cumulativeCost) {
+            cumulativeCost[i] = cost;
+        }
+        if (remainingFunds) {
+            remainingFunds[i] = calculateRemainingFunds(initialFunds, cost);
+        }
+    }
+    return count;
+}
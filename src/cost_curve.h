@@ -0,0 +1,38 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <cstddef>
+#include <vector>
+
+// Cumulative cost and remaining funds of a fleet for hours 0..horizon, for plotting.
+// The fleet is validated and summed once into a total hourly rate and daily storage cost;
+// each point is then cost(h) = rate * h + storage * calculateRunningDays(h), rounded to cents,
+// so storage jumps at the first hour of each day as in calculateTotalCost. Because rounding
+// happens once on the fleet total rather than per row, points can differ from
+// calculateTotalCostMultipleGpus by up to half a cent per fleet row.
+class CostCurve {
+public:
+    /**
+     * @param gpuModels Fleet to plot; checked with the multi-GPU calculators' rules
+     */
+    explicit CostCurve(const std::vector<GpuModel>& gpuModels);
+
+    double getHourlyRate() const;
+    double getDailyStorageCost() const;
+
+    // Cumulative cost after runningHours hours
+    double costAt(int runningHours) const;
+
+    // Number of points fill() writes: hours 0, stride, 2 * stride, ... and always horizonHours last
+    static std::size_t pointCount(int horizonHours, int strideHours);
+
+    // Write the series into caller-provided buffers of at least pointCount() entries; any
+    // buffer may be null to skip it. remainingFunds follows calculateRemainingFunds(funds, cost)
+    // and goes negative once the fleet overruns initialFunds. Returns the number of points.
+    std::size_t fill(double initialFunds, int horizonHours, int strideHours, int* hours,
+                     double* cumulativeCost, double* remainingFunds) const;
+
+private:
+    double hourlyRate = 0.0;
+    double dailyStorageCost = 0.0;
+};
@@ -0,0 +1,258 @@
+#include "csv_ingest.h"
+#include "fleet_csv.h"
+#include "parallel.h"
+#include "string_interner.h"
+#include "trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Positions of the first three commas and of the end of the line starting at p
+struct LineSplit {
+    const char* commas[3];
+    std::size_t commaCount;  // commas seen, including any past the third
+    const char* lineEnd;     // the '\n', or end
+};
+
+void splitLineScalar(const char* p, const char* end, LineSplit& split) {
+    for (; p < end; p++) {
+        if (*p == '\n') {
+            break;
+        }
+        if (*p == ',') {
+            if (split.commaCount < 3) {
+                split.commas[split.commaCount] = p;
+            }
+            split.commaCount++;
+        }
+    }
+    split.lineEnd = p;
+}
+
+LineSplit splitLine(const char* p, const char* end) {
+    LineSplit split;
+    split.commaCount = 0;
+#if defined(__SSE2__)
+    // 16 bytes at a time: one compare per delimiter, then walk the set bits of the mask
+    const __m128i commaBytes = _mm_set1_epi8(',');
+    const __m128i newlineBytes = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned commaMask = (unsigned)(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, commaBytes)));
+        unsigned newlineMask = (unsigned)(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newlineBytes)));
+        if (newlineMask != 0) {
+            // Only commas before the newline belong to this line
+            commaMask &= (newlineMask & (0u - newlineMask)) - 1;
+        }
+        while (commaMask != 0) {
+            int bit = __builtin_ctz(commaMask);
+            if (split.commaCount < 3) {
+                split.commas[split.commaCount] = p + bit;
+            }
+            split.commaCount++;
+            commaMask &= commaMask - 1;
+        }
+        if (newlineMask != 0) {
+            split.lineEnd = p + __builtin_ctz(newlineMask);
+            return split;
+        }
+        p += 16;
+    }
+#endif
+    splitLineScalar(p, end, split);
+    return split;
+}
+
+// One chunk's rows, with model ids local to the chunk and line numbers counted from its start
+struct ColumnBlock {
+    StringInterner names;
+    FleetColumns columns;
+    std::vector<CsvRowError> errors;
+    std::size_t errorRows = 0;
+    std::size_t lineCount = 0;
+};
+
+void parseChunk(const char* data, const char* begin, const char* end, const char* fileEnd,
+                std::size_t maxErrors, ColumnBlock& block) {
+    TRACE_SCOPE("csv chunk");
+    FleetColumns& columns = block.columns;
+    FleetCsvFields fields;
+    std::string error;
+
+    const char* p = begin;
+    while (p < end) {
+        LineSplit split = splitLine(p, fileEnd);
+        std::string_view line(p, (std::size_t)(split.lineEnd - p));
+        bool firstLine = p == data;
+        p = split.lineEnd < fileEnd ? split.lineEnd + 1 : fileEnd;
+        block.lineCount++;
+
+        if (line.empty() || line[0] == '#' || line == "\r" || (firstLine && line.rfind("name,", 0) == 0)) {
+            continue;
+        }
+
+        bool valid;
+        if (split.commaCount != 3) {
+            error = "Expected 4 comma-separated fields";
+            valid = false;
+        } else {
+            const char* lineStart = line.data();
+            valid = parseFleetCsvFieldValues(
+                std::string_view(lineStart, (std::size_t)(split.commas[0] - lineStart)),
+                std::string_view(split.commas[0] + 1, (std::size_t)(split.commas[1] - split.commas[0] - 1)),
+                std::string_view(split.commas[1] + 1, (std::size_t)(split.commas[2] - split.commas[1] - 1)),
+                std::string_view(split.commas[2] + 1, (std::size_t)(split.lineEnd - split.commas[2] - 1)),
+                fields, error);
+        }
+        if (!valid) {
+            if (block.errors.size() < maxErrors) {
+                block.errors.push_back(CsvRowError{block.lineCount, error});
+            }
+            block.errorRows++;
+            continue;
+        }
+
+        columns.modelIds.push_back(block.names.intern(fields.name));
+        columns.hourlyRates.push_back(fields.hourlyRate);
+        columns.dailyStorageCosts.push_back(fields.dailyStorageCost);
+        columns.numInstances.push_back(fields.numInstances);
+    }
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& path, const std::string& kind) {
+    auto fail = [&](int error) { return std::runtime_error(kind + " " + path + ": " + std::strerror(error)); };
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw fail(errno);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw fail(error);
+    }
+    length = (std::size_t)(info.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return;
+    }
+    void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw fail(errno);
+    }
+    ::madvise(mapped, length, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(mapped);
+}
+
+MappedFile::~MappedFile() {
+    if (data) {
+        ::munmap(const_cast<char*>(data), length);
+    }
+}
+
+const char* detail::lineStartAtOrAfter(const char* data, const char* p, const char* end) {
+    if (p == data) {
+        return p;
+    }
+    const char* newline = static_cast<const char*>(std::memchr(p - 1, '\n', (std::size_t)(end - (p - 1))));
+    return newline ? newline + 1 : end;
+}
+
+std::size_t FleetColumns::size() const {
+    return modelIds.size();
+}
+
+std::vector<GpuModel> FleetColumns::toGpuModels() const {
+    std::vector<GpuModel> gpuModels;
+    gpuModels.reserve(size());
+    for (std::size_t i = 0; i < size(); i++) {
+        gpuModels.push_back(GpuModel(modelNames[modelIds[i]], hourlyRates[i], dailyStorageCosts[i], numInstances[i]));
+    }
+    return gpuModels;
+}
+
+CsvIngestResult ingestFleetCsv(const std::string& path, const CsvIngestConfig& config) {
+    TRACE_SCOPE("csv ingest");
+    MappedFile file(path, "Fleet CSV");
+    return ingestFleetCsvBuffer(file.data, file.length, config);
+}
+
+CsvIngestResult ingestFleetCsvBuffer(const char* data, std::size_t length, const CsvIngestConfig& config) {
+    // Input validation
+    if (config.chunkBytes == 0) {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+
+    CsvIngestResult result;
+    if (length == 0) {
+        return result;
+    }
+    const char* fileEnd = data + length;
+    std::size_t chunkCount = (length + config.chunkBytes - 1) / config.chunkBytes;
+    std::vector<ColumnBlock> blocks(chunkCount);
+
+    parallelForLineChunks(data, length, config.chunkBytes, config.threadCount,
+                          [&](const char* begin, const char* end, std::size_t chunk) {
+                              parseChunk(data, begin, end, fileEnd, config.maxErrors, blocks[chunk]);
+                          });
+
+    // Merge in chunk order: names are re-interned so ids follow first appearance in the file,
+    // and chunk-local line numbers are shifted by the lines of earlier chunks
+    TRACE_SCOPE("csv merge");
+    StringInterner names;
+    std::vector<std::vector<std::uint32_t>> idMaps(chunkCount);
+    std::vector<std::size_t> rowOffsets(chunkCount + 1, 0);
+    std::size_t linesBefore = 0;
+    for (std::size_t c = 0; c < chunkCount; c++) {
+        ColumnBlock& block = blocks[c];
+        for (std::size_t id = 0; id < block.names.size(); id++) {
+            idMaps[c].push_back(names.intern(block.names.nameOf((std::uint32_t)(id))));
+        }
+        for (auto& error : block.errors) {
+            if (result.errors.size() < config.maxErrors) {
+                result.errors.push_back(CsvRowError{linesBefore + error.lineNumber, std::move(error.message)});
+            }
+        }
+        result.errorRows += block.errorRows;
+        linesBefore += block.lineCount;
+        rowOffsets[c + 1] = rowOffsets[c] + block.columns.size();
+    }
+    result.lineCount = linesBefore;
+
+    FleetColumns& fleet = result.fleet;
+    for (std::size_t id = 0; id < names.size(); id++) {
+        fleet.modelNames.push_back(names.nameOf((std::uint32_t)(id)));
+    }
+    std::size_t rows = rowOffsets[chunkCount];
+    fleet.modelIds.resize(rows);
+    fleet.hourlyRates.resize(rows);
+    fleet.dailyStorageCosts.resize(rows);
+    fleet.numInstances.resize(rows);
+
+    parallelForChunks(chunkCount, 1, config.threadCount, [&](std::size_t c, std::size_t, std::size_t) {
+        const FleetColumns& block = blocks[c].columns;
+        std::size_t offset = rowOffsets[c];
+        for (std::size_t i = 0; i < block.size(); i++) {
+            fleet.modelIds[offset + i] = idMaps[c][block.modelIds[i]];
+        }
+        std::copy(block.hourlyRates.begin(), block.hourlyRates.end(), fleet.hourlyRates.begin() + offset);
+        std::copy(block.dailyStorageCosts.begin(), block.dailyStorageCosts.end(),
+                  fleet.dailyStorageCosts.begin() + offset);
+        std::copy(block.numInstances.begin(), block.numInstances.end(), fleet.numInstances.begin() + offset);
+    });
+    return result;
+}
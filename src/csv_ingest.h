@@ -0,0 +1,86 @@
+#pragma once
+
+#include "gpu_model.h"
+#include "parallel.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A fleet catalog as columns, with model names stored once and referenced by id
+struct FleetColumns {
+    std::vector<std::string> modelNames;  // by id, in order of first appearance in the file
+    std::vector<std::uint32_t> modelIds;
+    std::vector<double> hourlyRates;
+    std::vector<double> dailyStorageCosts;
+    std::vector<int> numInstances;
+
+    std::size_t size() const;
+    std::vector<GpuModel> toGpuModels() const;
+};
+
+struct CsvRowError {
+    std::size_t lineNumber;
+    std::string message;
+};
+
+struct CsvIngestConfig {
+    unsigned threadCount = 0;            // 0 = all cores
+    std::size_t chunkBytes = 16u << 20;  // bytes of input per parse task
+    std::size_t maxErrors = 1000;        // row errors kept; errorRows counts them all
+};
+
+struct CsvIngestResult {
+    FleetColumns fleet;
+    std::vector<CsvRowError> errors;  // the first maxErrors, in line order
+    std::size_t errorRows = 0;
+    std::size_t lineCount = 0;
+};
+
+// Read a fleet CSV (the rows of parseFleetCsvRow, skipping blank lines, '#' comments and a
+// leading "name,..." header as runBulkPipeline does) by mapping the file and parsing it in
+// parallel. The input is cut into chunkBytes pieces moved forward to line starts; each piece
+// is split into fields with an SSE2 scan for ',' and '\n' (a scalar loop elsewhere), numbers are
+// read with std::from_chars through parseFleetCsvFieldValues, so invalid rows get the same
+// messages, and rows go into the piece's own column block. Blocks are merged in file order
+// at the end, so the result doesn't depend on the thread count.
+// Throws std::runtime_error if the file can't be read.
+CsvIngestResult ingestFleetCsv(const std::string& path, const CsvIngestConfig& config = CsvIngestConfig());
+
+// The same over text already in memory
+CsvIngestResult ingestFleetCsvBuffer(const char* data, std::size_t length,
+                                     const CsvIngestConfig& config = CsvIngestConfig());
+
+// Read-only memory map of a file, unmapped on destruction. Throws std::runtime_error
+// "<kind> <path>: <reason>" if the file can't be read; an empty file maps to no data.
+class MappedFile {
+public:
+    MappedFile(const std::string& path, const std::string& kind);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data = nullptr;
+    std::size_t length = 0;
+};
+
+namespace detail {
+
+// A line starts at data and after every '\n'; a chunk owns the lines that start inside it
+const char* lineStartAtOrAfter(const char* data, const char* p, const char* end);
+
+} // namespace detail
+
+// Run fn(begin, end, chunk) on threadCount threads over chunkBytes pieces of the text, each
+// moved forward to a line start so every line falls in exactly one piece. Pieces depend only
+// on chunkBytes, so per-piece results merged in chunk order don't depend on the thread count.
+template <typename Fn>
+void parallelForLineChunks(const char* data, std::size_t length, std::size_t chunkBytes, unsigned threadCount,
+                           Fn fn) {
+    const char* end = data + length;
+    parallelForChunks(length, chunkBytes, threadCount, [&](std::size_t begin, std::size_t stop, std::size_t chunk) {
+        fn(detail::lineStartAtOrAfter(data, data + begin, end), detail::lineStartAtOrAfter(data, data + stop, end),
+           chunk);
+    });
+}
@@ -0,0 +1,94 @@
+#include "demand_curve.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+DemandCurveCost priceDemandCurve(const std::vector<GpuModel>& gpuModels, const int* instancesPerHour,
+                                 std::size_t hours, double initialFunds) {
+    // Input validation
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    for (const GpuModel& gpu : gpuModels) {
+        if (gpu.getHourlyRate() < 0) {
+            throw std::invalid_argument("GPU hourly rate can't be negative");
+        }
+        if (gpu.getDailyStorageCost() < 0) {
+            throw std::invalid_argument("GPU daily storage cost can't be negative");
+        }
+    }
+    for (std::size_t i = 0; i < gpuModels.size() * hours; i++) {
+        if (instancesPerHour[i] < 0) {
+            throw std::invalid_argument("Instance count can't be negative");
+        }
+    }
+
+    // runtimeSpend[h] and storageSpend[h] are summed over models, one contiguous pass per model
+    std::vector<double> runtimeSpend(hours, 0.0);
+    std::vector<double> storageSpend(hours, 0.0);
+    double totalCost = 0.0;
+    for (std::size_t m = 0; m < gpuModels.size(); m++) {
+        const int* row = instancesPerHour + m * hours;
+        double rate = gpuModels[m].getHourlyRate();
+        double storage = gpuModels[m].getDailyStorageCost();
+
+        double instanceHours = 0.0;
+        for (std::size_t h = 0; h < hours; h++) {
+            runtimeSpend[h] += rate * (double)(row[h]);
+            instanceHours += (double)(row[h]);
+        }
+
+        double storedInstanceDays = 0.0;
+        for (std::size_t dayStart = 0; dayStart < hours; dayStart += 24) {
+            std::size_t dayEnd = std::min(hours, dayStart + 24);
+            int peak = *std::max_element(row + dayStart, row + dayEnd);
+            storageSpend[dayStart] += storage * (double)(peak);
+            storedInstanceDays += (double)(peak);
+        }
+
+        double modelCost = rate * instanceHours + storage * storedInstanceDays;
+        totalCost += std::round(modelCost * 100.0) / 100.0;
+    }
+
+    DemandCurveCost result;
+    result.totalCost = totalCost;
+    result.cumulativeCost.resize(hours);
+    result.fundsExhaustedHour = -1;
+
+    double spent = 0.0;
+    for (std::size_t h = 0; h < hours; h++) {
+        double beforeHour = spent;
+        spent += storageSpend[h] + runtimeSpend[h];
+        result.cumulativeCost[h] = spent;
+
+        if (result.fundsExhaustedHour < 0 && spent >= initialFunds) {
+            double afterStorage = initialFunds - beforeHour - storageSpend[h];
+            if (afterStorage <= 0 || runtimeSpend[h] <= 0) {
+                result.fundsExhaustedHour = (double)(h);
+            } else {
+                result.fundsExhaustedHour = (double)(h) + afterStorage / runtimeSpend[h];
+            }
+        }
+    }
+    return result;
+}
+
+DemandCurveCost priceDemandCurve(const std::vector<GpuModel>& gpuModels,
+                                 const std::vector<std::vector<int>>& instancesPerHour, double initialFunds) {
+    if (instancesPerHour.size() != gpuModels.size()) {
+        throw std::invalid_argument("Demand curves must match the GPU models");
+    }
+    std::size_t hours = gpuModels.empty() ? 0 : instancesPerHour[0].size();
+    std::vector<int> flat;
+    flat.reserve(gpuModels.size() * hours);
+    for (const std::vector<int>& curve : instancesPerHour) {
+        if (curve.size() != hours) {
+            throw std::invalid_argument("Demand curves must all have the same length");
+        }
+        flat.insert(flat.end(), curve.begin(), curve.end());
+    }
+    return priceDemandCurve(gpuModels, flat.data(), hours, initialFunds);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <cstddef>
+#include <vector>
+
+struct DemandCurveCost {
+    double totalCost;                   // sum over models of the model's cost rounded to cents
+    std::vector<double> cumulativeCost; // cumulativeCost[h] = spend by the end of hour h (unrounded)
+    double fundsExhaustedHour;          // when initialFunds run out; -1 if they last the whole curve
+};
+
+// Price an autoscaling plan. instancesPerHour is row-major, gpuModels.size() rows of `hours`
+// instance counts each (zero is allowed); GpuModel::getNumInstances() is not used.
+// Runtime is billed per instance-hour. Storage follows calculateRunningDays: each day the curve
+// touches is billed on that day's peak instance count, charged at the start of the day. For a
+// flat curve the total equals calculateTotalCostMultipleGpus, and exhaustion within an hour
+// follows calculateFundsDuration (storage first, then runtime).
+DemandCurveCost priceDemandCurve(const std::vector<GpuModel>& gpuModels, const int* instancesPerHour,
+                                 std::size_t hours, double initialFunds);
+
+DemandCurveCost priceDemandCurve(const std::vector<GpuModel>& gpuModels,
+                                 const std::vector<std::vector<int>>& instancesPerHour, double initialFunds);
@@ -0,0 +1,127 @@
+#include "deposit_runway.h"
+#include "batch_kernels.h"
+#include "funds_calculator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Fleet burn: R per hour plus S at each day start, or S / 24 per hour when R is zero.
+struct Burn {
+    double R;
+    double S;
+
+    double costBetween(double t, double t2) const { return spendBetween(t, t2, R, S); }
+
+    double exhaustedAt(double t, double funds) const { return fundsExhaustedAt(t, funds, R, S); }
+};
+
+} // namespace
+
+DepositRunway calculateFundsDurationWithDeposits(double initialFunds, double hourlyRate, int numInstances,
+                                                 double dailyStorageCost, const std::vector<Deposit>& deposits,
+                                                 const AutoRecharge& recharge) {
+    // Input validation
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+    if (hourlyRate < 0) {
+        throw std::invalid_argument("Hourly rate can't be negative");
+    }
+    if (dailyStorageCost < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+    for (const auto& deposit : deposits) {
+        if (!(deposit.hour >= 0)) {
+            throw std::invalid_argument("Deposit hour can't be negative");
+        }
+        if (!(deposit.amount >= 0)) {
+            throw std::invalid_argument("Deposit amount can't be negative");
+        }
+    }
+    if (recharge.floorBalance < 0) {
+        throw std::invalid_argument("Recharge floor can't be negative");
+    }
+    if (recharge.amount < 0) {
+        throw std::invalid_argument("Recharge amount can't be negative");
+    }
+
+    Burn burn{hourlyRate * numInstances, dailyStorageCost * numInstances};
+    if (burn.R <= 0 && burn.S <= 0) {
+        return DepositRunway{-1, 0, 0.0};
+    }
+    bool rechargeActive = recharge.amount > 0 && recharge.maxRecharges != 0;
+    if (rechargeActive && recharge.maxRecharges < 0) {
+        return DepositRunway{-1, 0, 0.0};
+    }
+
+    std::vector<Deposit> schedule(deposits);
+    std::stable_sort(schedule.begin(), schedule.end(),
+                     [](const Deposit& a, const Deposit& b) { return a.hour < b.hour; });
+
+    const double never = std::numeric_limits<double>::infinity();
+    DepositRunway result{0.0, 0, 0.0};
+    double t = 0.0;
+    double balance = initialFunds;
+    std::size_t next = 0;
+    while (true) {
+        while (next < schedule.size() && schedule[next].hour <= t) {
+            balance += schedule[next].amount;
+            result.totalDeposited += schedule[next].amount;
+            next++;
+        }
+
+        double nextDeposit = next < schedule.size() ? schedule[next].hour : never;
+        double exhausted = burn.exhaustedAt(t, balance);
+
+        // Falling to the floor is running out of (balance - floor), so it's found the same way
+        if (rechargeActive && result.recharges < recharge.maxRecharges) {
+            double atFloor = burn.exhaustedAt(t, balance - recharge.floorBalance);
+            if (atFloor < nextDeposit) {
+                balance -= burn.costBetween(t, atFloor);
+                balance += recharge.amount;
+                result.totalDeposited += recharge.amount;
+                result.recharges++;
+                t = atFloor;
+                continue;
+            }
+        }
+
+        if (exhausted < nextDeposit) {
+            result.runwayHours = exhausted;
+            return result;
+        }
+        // The balance at the deposit is before that hour's storage, so a deposit due at the
+        // boundary where storage would have run the wallet dry still keeps it going
+        double balanceAtDeposit = balance - burn.costBetween(t, nextDeposit);
+        if (balanceAtDeposit <= 0) {
+            result.runwayHours = exhausted;
+            return result;
+        }
+        balance = balanceAtDeposit;
+        t = nextDeposit;
+    }
+}
+
+DepositRunway calculateFundsDurationWithDepositsMultipleGpus(double initialFunds, const std::vector<GpuModel>& gpuModels,
+                                                             const std::vector<Deposit>& deposits,
+                                                             const AutoRecharge& recharge) {
+    // Input validation
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    double totalHourlyRate = 0.0;
+    double totalDailyStorageCost = 0.0;
+    for (const auto& gpu : gpuModels) {
+        detail::validateFleetRow(gpu);
+        totalHourlyRate += gpu.getHourlyRate() * gpu.getNumInstances();
+        totalDailyStorageCost += gpu.getDailyStorageCost() * gpu.getNumInstances();
+    }
+    return calculateFundsDurationWithDeposits(initialFunds, totalHourlyRate, 1, totalDailyStorageCost, deposits,
+                                              recharge);
+}
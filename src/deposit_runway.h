@@ -0,0 +1,42 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <vector>
+
+// A top-up of amount dollars arriving at hour (0 = start of the run)
+struct Deposit {
+    double hour;
+    double amount;
+};
+
+// Adds amount whenever the balance falls to floorBalance, at most maxRecharges times
+// (-1 for no limit). The default rule never fires.
+struct AutoRecharge {
+    double floorBalance = 0.0;
+    double amount = 0.0;
+    int maxRecharges = 0;
+};
+
+struct DepositRunway {
+    double runwayHours;    // -1 if the funds never run out
+    int recharges;         // auto-recharges that fired before the funds ran out
+    double totalDeposited; // scheduled deposits and recharges that arrived before the funds ran out
+};
+
+// calculateFundsDuration for a wallet that also receives scheduled deposits and auto-recharges.
+// Billing is as in calculateFundsDuration: storage at the start of each day, then compute by
+// the hour (storage-only fleets burn storage / 24 per hour). Deposits due at a day boundary
+// arrive before that day's storage is charged; once the balance reaches zero the run is over
+// and later deposits don't restart it.
+//
+// The balance is swept from event to event (deposits and recharges), with the runway between
+// events taken from the closed form in closedFormFundsDuration, so the cost is linear in the
+// number of events and independent of the number of days. Deposits need not be sorted.
+// Unlimited recharges with a positive amount keep the wallet above zero forever (-1).
+DepositRunway calculateFundsDurationWithDeposits(double initialFunds, double hourlyRate, int numInstances,
+                                                 double dailyStorageCost, const std::vector<Deposit>& deposits,
+                                                 const AutoRecharge& recharge = AutoRecharge());
+
+DepositRunway calculateFundsDurationWithDepositsMultipleGpus(double initialFunds, const std::vector<GpuModel>& gpuModels,
+                                                             const std::vector<Deposit>& deposits,
+                                                             const AutoRecharge& recharge = AutoRecharge());
@@ -0,0 +1,100 @@
+#include "fleet_aggregation.h"
+#include "funds_calculator.h"
+#include "parallel.h"
+#include "string_interner.h"
+#include <stdexcept>
+
+namespace {
+
+const std::size_t AGGREGATION_CHUNK_SIZE = 1 << 16;
+
+struct PartialAggregate {
+    StringInterner names;
+    std::vector<ModelAggregate> models; // indexed by local interned id
+    const GpuModel* invalidRow = nullptr; // first row failing the fleet row check
+};
+
+void addInto(ModelAggregate& into, const ModelAggregate& from) {
+    into.rows += from.rows;
+    into.instances += from.instances;
+    into.runtimeCost += from.runtimeCost;
+    into.storageCost += from.storageCost;
+    into.totalCost += from.totalCost;
+    into.hourlyBurn += from.hourlyBurn;
+}
+
+} // namespace
+
+FleetAggregateReport aggregateFleetByModel(const std::vector<GpuModel>& gpuModels, int runningHours,
+                                           unsigned threadCount) {
+    // Input validation
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+
+    int days = calculateRunningDays(runningHours);
+    std::size_t chunkCount = (gpuModels.size() + AGGREGATION_CHUNK_SIZE - 1) / AGGREGATION_CHUNK_SIZE;
+    std::vector<PartialAggregate> partials(chunkCount);
+
+    parallelForChunks(gpuModels.size(), AGGREGATION_CHUNK_SIZE, threadCount,
+                      [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        PartialAggregate& partial = partials[chunk];
+        for (std::size_t i = begin; i < end; i++) {
+            const GpuModel& gpu = gpuModels[i];
+            if (!detail::isValidFleetRow(gpu)) {
+                partial.invalidRow = &gpu;
+                return;
+            }
+
+            std::uint32_t id = partial.names.intern(gpu.getName());
+            if (id == partial.models.size()) {
+                partial.models.push_back(ModelAggregate{gpu.getName(), 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0});
+            }
+
+            ModelAggregate& model = partial.models[id];
+            double instances = (double)(gpu.getNumInstances());
+            model.rows++;
+            model.instances += gpu.getNumInstances();
+            model.runtimeCost += gpu.getHourlyRate() * instances * (double)(runningHours);
+            model.storageCost += gpu.getDailyStorageCost() * instances * (double)(days);
+            model.totalCost += calculateTotalCost(gpu.getHourlyRate(), gpu.getNumInstances(),
+                                                  runningHours, gpu.getDailyStorageCost());
+            model.hourlyBurn += instances * (gpu.getHourlyRate() + gpu.getDailyStorageCost() / 24.0);
+        }
+    });
+
+    // The first invalid row in fleet order decides the error, whichever thread found it
+    for (const auto& partial : partials) {
+        if (partial.invalidRow) {
+            detail::validateFleetRow(*partial.invalidRow);
+        }
+    }
+
+    // Merging in chunk order assigns global ids in the same first-appearance order a
+    // serial pass would, and adds the floating point partials in a fixed order
+    FleetAggregateReport report{{}, 0, 0.0, 0.0};
+    StringInterner globalNames;
+    for (const auto& partial : partials) {
+        for (const auto& model : partial.models) {
+            std::uint32_t id = globalNames.intern(model.name);
+            if (id == report.models.size()) {
+                report.models.push_back(model);
+            } else {
+                addInto(report.models[id], model);
+            }
+        }
+    }
+
+    for (const auto& model : report.models) {
+        report.totalInstances += model.instances;
+        report.totalCost += model.totalCost;
+        report.totalHourlyBurn += model.hourlyBurn;
+    }
+    for (auto& model : report.models) {
+        model.burnShare = report.totalHourlyBurn > 0 ? model.hourlyBurn / report.totalHourlyBurn : 0.0;
+    }
+    return report;
+}
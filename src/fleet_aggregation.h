@@ -0,0 +1,31 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Totals for every fleet row sharing one model name
+struct ModelAggregate {
+    std::string name;
+    std::size_t rows;
+    long long instances;
+    double runtimeCost;   // hourlyRate * instances * runningHours
+    double storageCost;   // dailyStorageCost * instances * running days
+    double totalCost;     // sum of calculateTotalCost over the rows
+    double hourlyBurn;    // instances * (hourlyRate + dailyStorageCost / 24)
+    double burnShare;     // hourlyBurn as a fraction of the fleet's hourly burn
+};
+
+struct FleetAggregateReport {
+    std::vector<ModelAggregate> models; // in first-appearance order of the name
+    long long totalInstances;
+    double totalCost;
+    double totalHourlyBurn;
+};
+
+// Group the fleet by model name and total each group for runningHours hours.
+// Rows are processed in fixed-size chunks on threadCount threads (0 = hardware concurrency);
+// partial results are merged in chunk order, so the report is bit-identical for any thread count.
+FleetAggregateReport aggregateFleetByModel(const std::vector<GpuModel>& gpuModels, int runningHours,
+                                           unsigned threadCount = 0);
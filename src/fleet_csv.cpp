@@ -0,0 +1,98 @@
+#include "fleet_csv.h"
+#include <cmath>
+
+namespace detail {
+
+std::string_view trimCsvField(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+bool nextCsvField(std::string_view& rest, std::string_view& field) {
+    std::size_t comma = rest.find(',');
+    if (comma == std::string_view::npos) {
+        return false;
+    }
+    field = trimCsvField(rest.substr(0, comma));
+    rest.remove_prefix(comma + 1);
+    return true;
+}
+
+bool splitCsvRow(std::string_view line, std::string_view (&fields)[4], std::string& error) {
+    std::string_view rest = line;
+    if (!nextCsvField(rest, fields[0]) || !nextCsvField(rest, fields[1]) || !nextCsvField(rest, fields[2])) {
+        error = "Expected 4 comma-separated fields";
+        return false;
+    }
+    fields[3] = trimCsvField(rest);
+    if (fields[3].find(',') != std::string_view::npos) {
+        error = "Expected 4 comma-separated fields";
+        return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+bool parseFleetCsvFieldValues(std::string_view name, std::string_view rate, std::string_view storage,
+                              std::string_view instances, FleetCsvFields& fields, std::string& error) {
+    name = detail::trimCsvField(name);
+    rate = detail::trimCsvField(rate);
+    storage = detail::trimCsvField(storage);
+    instances = detail::trimCsvField(instances);
+
+    if (name.empty()) {
+        error = "GPU model name can't be empty";
+        return false;
+    }
+    if (!detail::parseCsvNumber(rate, fields.hourlyRate) || !std::isfinite(fields.hourlyRate)) {
+        error = "Invalid hourly rate";
+        return false;
+    }
+    if (!detail::parseCsvNumber(storage, fields.dailyStorageCost) || !std::isfinite(fields.dailyStorageCost)) {
+        error = "Invalid daily storage cost";
+        return false;
+    }
+    if (!detail::parseCsvNumber(instances, fields.numInstances)) {
+        error = "Invalid instance count";
+        return false;
+    }
+
+    if (fields.hourlyRate < 0) {
+        error = "GPU hourly rate can't be negative";
+        return false;
+    }
+    if (fields.dailyStorageCost < 0) {
+        error = "GPU daily storage cost can't be negative";
+        return false;
+    }
+    if (fields.numInstances <= 0) {
+        error = "GPU instance count must be positive";
+        return false;
+    }
+
+    fields.name = name;
+    return true;
+}
+
+bool parseFleetCsvFields(std::string_view line, FleetCsvFields& fields, std::string& error) {
+    std::string_view values[4];
+    if (!detail::splitCsvRow(line, values, error)) {
+        return false;
+    }
+    return parseFleetCsvFieldValues(values[0], values[1], values[2], values[3], fields, error);
+}
+
+bool parseFleetCsvRow(std::string_view line, GpuModel& gpu, std::string& error) {
+    FleetCsvFields fields;
+    if (!parseFleetCsvFields(line, fields, error)) {
+        return false;
+    }
+    gpu = GpuModel(std::string(fields.name), fields.hourlyRate, fields.dailyStorageCost, fields.numInstances);
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <charconv>
+#include <string>
+#include <string_view>
+
+// Fields of one fleet CSV row; name points into the parsed line
+struct FleetCsvFields {
+    std::string_view name;
+    double hourlyRate;
+    double dailyStorageCost;
+    int numInstances;
+};
+
+// Parse one fleet CSV row of the form
+//     name,hourlyRate,dailyStorageCost,numInstances
+// Surrounding spaces and a trailing '\r' are ignored. On failure returns false and sets
+// error to a message; rows that parse but break the calculator's rules use the same
+// messages as calculateTotalCostMultipleGpus.
+bool parseFleetCsvFields(std::string_view line, FleetCsvFields& fields, std::string& error);
+
+// The value checks of parseFleetCsvFields, for callers that have already split the line
+// (trimming is done here)
+bool parseFleetCsvFieldValues(std::string_view name, std::string_view rate, std::string_view storage,
+                              std::string_view instances, FleetCsvFields& fields, std::string& error);
+
+bool parseFleetCsvRow(std::string_view line, GpuModel& gpu, std::string& error);
+
+namespace detail {
+
+// Field helpers shared by the CSV readers (fleet rows here, billing exports in reconciliation)
+std::string_view trimCsvField(std::string_view text);
+
+// Split off the text up to the next comma, trimmed; returns false if there is no comma
+bool nextCsvField(std::string_view& rest, std::string_view& field);
+
+// Split a line into exactly four trimmed fields; otherwise returns false and sets error
+bool splitCsvRow(std::string_view line, std::string_view (&fields)[4], std::string& error);
+
+// The whole of text as a number; false if it's empty, malformed or out of range
+template <typename Number>
+bool parseCsvNumber(std::string_view text, Number& value) {
+    const char* end = text.data() + text.size();
+    std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && !text.empty();
+}
+
+} // namespace detail
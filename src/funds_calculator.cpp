@@ -21,12 +21,7 @@ double calculateTotalCost(double hourlyRate, int instanceCount, int runningHours
         throw std::invalid_argument("Hourly rate can't be negative");
     }
 
-    double runtimeCost = hourlyRate * (double)(instanceCount) * (double)(runningHours);
-    
-    int days = calculateRunningDays(runningHours);
-    double storageCost = dailyStorageCost * (double)(instanceCount) * (double)(days);
-    
-    double totalCost = runtimeCost + storageCost;
+    double totalCost = detail::totalCostBeforeRounding(hourlyRate, instanceCount, runningHours, dailyStorageCost);
 
     return std::round(totalCost * 100.0) / 100.0; 
 }
@@ -117,80 +112,9 @@ double calculateFundsDuration(double initialFunds, double hourlyRate, int instan
 }
 
 double calculateTotalCostMultipleGpus(const std::vector<GpuModel>& gpuModels, int runningHours) {
-    // Input validation
-    if (gpuModels.empty()) {
-        throw std::invalid_argument("GPU models list can't be empty");
-    }
-    if (runningHours < 0) {
-        throw std::invalid_argument("Running hours can't be negative");
-    }
-
-    for (const auto& gpu : gpuModels) {
-        if (gpu.getHourlyRate() < 0) {
-            throw std::invalid_argument("GPU hourly rate can't be negative");
-        }
-        if (gpu.getDailyStorageCost() < 0) {
-            throw std::invalid_argument("GPU daily storage cost can't be negative");
-        }
-        if (gpu.getNumInstances() <= 0) {
-            throw std::invalid_argument("GPU instance count must be positive");
-        }
-    }
-    
-    double totalCost = 0.0;
-    for (const auto& gpu : gpuModels) {
-        totalCost += calculateTotalCost(gpu.getHourlyRate(), gpu.getNumInstances(), 
-                                        runningHours, gpu.getDailyStorageCost());
-    }
-    return totalCost;
+    return calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), runningHours);
 }
 
-
 double calculateFundsDurationMultipleGpus(double initialFunds, const std::vector<GpuModel>& gpuModels) {
-    // Input validation for negative values
-    if (initialFunds < 0) {
-        throw std::invalid_argument("Initial funds can't be negative");
-    }
-    if (gpuModels.empty()) {
-        throw std::invalid_argument("GPU models list can't be empty");
-    }
-    
-    // Validate each GPU model
-    for (const auto& gpu : gpuModels) {
-        if (gpu.getHourlyRate() < 0) {
-            throw std::invalid_argument("GPU hourly rate can't be negative");
-        }
-        if (gpu.getDailyStorageCost() < 0) {
-            throw std::invalid_argument("GPU daily storage cost can't be negative");
-        }
-        if (gpu.getNumInstances() <= 0) {
-            throw std::invalid_argument("GPU instance count must be positive");
-        }
-    }
-    
-    // Special case for zero initial funds
-    if (initialFunds == 0) {
-        return 0.0;
-    }
-
-    double totalHourlyRate = 0.0;
-    double totalDailyStorageCost = 0.0;
-    int totalInstances = 0;
-
-    for (const auto& gpu: gpuModels) {
-        totalHourlyRate += gpu.getHourlyRate() * gpu.getNumInstances();
-        totalDailyStorageCost += gpu.getDailyStorageCost() * gpu.getNumInstances();
-        totalInstances += gpu.getNumInstances();
-    }
-
-    // if (totalInstances == 0) {
-    //     return 0.0;
-    // }
-
-    if (totalHourlyRate <= 0 && totalDailyStorageCost <= 0) {
-        return -1;
-    }
-
-    return calculateFundsDuration(initialFunds, totalHourlyRate, 1, totalDailyStorageCost);
+    return calculateFundsDurationMultipleGpus(initialFunds, gpuModels.begin(), gpuModels.end());
 }
-
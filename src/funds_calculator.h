@@ -1,6 +1,11 @@
 #pragma once
 
 #include "gpu_model.h"
+#include "parallel.h"
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 #include <stdexcept>
 
@@ -24,4 +29,175 @@ double calculateTotalCostMultipleGpus(const std::vector<GpuModel>& gpuModels, in
 
 double calculateFundsDurationMultipleGpus(double initialFunds, const std::vector<GpuModel>& gpuModels);
 
+// Range versions of the multi-GPU calculators. Any element type with getHourlyRate(),
+// getDailyStorageCost() and getNumInstances() works, so fleets held in arenas, pmr
+// containers or mapped files (e.g. a pointer pair) can be priced without copying into a vector.
+//
+// The total is summed in whole cents (each row's cost is already rounded to cents), so it is
+// exact and the same for any row order, chunking or thread count. Random-access fleets of
+// PARALLEL_TOTAL_MIN_ROWS rows or more are summed on threadCount threads (0 = all cores).
+template <typename Iterator>
+double calculateTotalCostMultipleGpus(Iterator first, Iterator last, int runningHours);
+
+template <typename Iterator>
+double calculateTotalCostMultipleGpus(Iterator first, Iterator last, int runningHours, unsigned threadCount);
+
+template <typename Iterator>
+double calculateFundsDurationMultipleGpus(double initialFunds, Iterator first, Iterator last);
+
+const std::size_t PARALLEL_TOTAL_MIN_ROWS = 1 << 18;
+const std::size_t PARALLEL_TOTAL_CHUNK_ROWS = 1 << 16;
+
+namespace detail {
+
+// calculateTotalCost before rounding to cents. Number is double, or a type such as Interval
+// with the same arithmetic operators.
+template <typename Number>
+Number totalCostBeforeRounding(const Number& hourlyRate, int numInstances, int runningHours,
+                               const Number& dailyStorageCost) {
+    Number runtimeCost = hourlyRate * Number((double)(numInstances)) * Number((double)(runningHours));
+    Number storageCost = dailyStorageCost * Number((double)(numInstances)) *
+                         Number((double)(calculateRunningDays(runningHours)));
+    return runtimeCost + storageCost;
+}
+
+// The one fleet row check, shared by the serial and parallel paths: the message for the first
+// rule the row breaks, or nullptr if it's valid. Non-finite rates and storage costs are rejected
+// explicitly, since NaN compares false both ways and would otherwise slip past either check.
+template <typename Model>
+const char* fleetRowError(const Model& gpu) {
+    if (!std::isfinite(gpu.getHourlyRate())) {
+        return "GPU hourly rate must be finite";
+    }
+    if (gpu.getHourlyRate() < 0) {
+        return "GPU hourly rate can't be negative";
+    }
+    if (!std::isfinite(gpu.getDailyStorageCost())) {
+        return "GPU daily storage cost must be finite";
+    }
+    if (gpu.getDailyStorageCost() < 0) {
+        return "GPU daily storage cost can't be negative";
+    }
+    if (gpu.getNumInstances() <= 0) {
+        return "GPU instance count must be positive";
+    }
+    return nullptr;
+}
+
+template <typename Model>
+void validateFleetRow(const Model& gpu) {
+    if (const char* error = fleetRowError(gpu)) {
+        throw std::invalid_argument(error);
+    }
+}
+
+template <typename Model>
+bool isValidFleetRow(const Model& gpu) {
+    return fleetRowError(gpu) == nullptr;
+}
+
+template <typename Model>
+std::int64_t rowCostCents(const Model& gpu, int runningHours) {
+    return std::llround(calculateTotalCost(gpu.getHourlyRate(), gpu.getNumInstances(), runningHours,
+                                           gpu.getDailyStorageCost()) * 100.0);
+}
+
+} // namespace detail
+
+
+template <typename Iterator>
+double calculateTotalCostMultipleGpus(Iterator first, Iterator last, int runningHours) {
+    return calculateTotalCostMultipleGpus(first, last, runningHours, 0);
+}
+
+template <typename Iterator>
+double calculateTotalCostMultipleGpus(Iterator first, Iterator last, int runningHours, unsigned threadCount) {
+    // Input validation
+    if (first == last) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+    if constexpr (std::is_base_of<std::random_access_iterator_tag, Category>::value) {
+        std::size_t count = (std::size_t)(last - first);
+        if (count >= PARALLEL_TOTAL_MIN_ROWS && threadCount != 1) {
+            // Each chunk validates and sums its own rows; the first invalid row in fleet order
+            // decides the error, so the message doesn't depend on which thread found it
+            std::size_t chunkCount = (count + PARALLEL_TOTAL_CHUNK_ROWS - 1) / PARALLEL_TOTAL_CHUNK_ROWS;
+            std::vector<std::int64_t> chunkCents(chunkCount, 0);
+            std::vector<std::size_t> chunkInvalidRow(chunkCount, count);
+            parallelForChunks(count, PARALLEL_TOTAL_CHUNK_ROWS, threadCount,
+                              [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+                std::int64_t cents = 0;
+                for (std::size_t i = begin; i < end; i++) {
+                    const auto& gpu = first[i];
+                    if (!detail::isValidFleetRow(gpu)) {
+                        chunkInvalidRow[chunk] = i;
+                        return;
+                    }
+                    cents += detail::rowCostCents(gpu, runningHours);
+                }
+                chunkCents[chunk] = cents;
+            });
+
+            std::int64_t totalCents = 0;
+            for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+                if (chunkInvalidRow[chunk] != count) {
+                    detail::validateFleetRow(first[chunkInvalidRow[chunk]]);
+                }
+                totalCents += chunkCents[chunk];
+            }
+            return (double)(totalCents) / 100.0;
+        }
+    }
+
+    for (Iterator it = first; it != last; ++it) {
+        detail::validateFleetRow(*it);
+    }
+
+    std::int64_t totalCents = 0;
+    for (Iterator it = first; it != last; ++it) {
+        totalCents += detail::rowCostCents(*it, runningHours);
+    }
+    return (double)(totalCents) / 100.0;
+}
+
+template <typename Iterator>
+double calculateFundsDurationMultipleGpus(double initialFunds, Iterator first, Iterator last) {
+    // Input validation for negative values
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (first == last) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+
+    // Validate each GPU model
+    for (Iterator it = first; it != last; ++it) {
+        detail::validateFleetRow(*it);
+    }
+
+    // Special case for zero initial funds
+    if (initialFunds == 0) {
+        return 0.0;
+    }
+
+    double totalHourlyRate = 0.0;
+    double totalDailyStorageCost = 0.0;
+
+    for (Iterator it = first; it != last; ++it) {
+        totalHourlyRate += it->getHourlyRate() * it->getNumInstances();
+        totalDailyStorageCost += it->getDailyStorageCost() * it->getNumInstances();
+    }
+
+    if (totalHourlyRate <= 0 && totalDailyStorageCost <= 0) {
+        return -1;
+    }
+
+    return calculateFundsDuration(initialFunds, totalHourlyRate, 1, totalDailyStorageCost);
+}
+
 
@@ -9,7 +9,7 @@ GpuModel::GpuModel()
     : name("Default"), hourlyRate(0.0), dailyStorageCost(0.0), numInstances(1) {
 }
 
-std::string GpuModel::getName() const {
+const std::string& GpuModel::getName() const {
 
     return name;
 }
@@ -16,7 +16,7 @@ public:
 
     GpuModel();
     
-    std::string getName() const;
+    const std::string& getName() const;
     double getHourlyRate() const;
     double getDailyStorageCost() const;
     int getNumInstances() const;
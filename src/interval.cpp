@@ -0,0 +1,306 @@
+#include "interval.h"
+#include "batch_kernels.h"
+#include "funds_calculator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+// Directed rounding from the exact error of each operation: the rounded result is moved one
+// ulp outward only on the side where the exact result lies, so exact operations stay exact.
+// The errors are NaN for infinite operands, which then stay as they are.
+double roundedDown(double result, double error) {
+    return error < 0 ? std::nextafter(result, -INF) : result;
+}
+
+double roundedUp(double result, double error) {
+    return error > 0 ? std::nextafter(result, INF) : result;
+}
+
+// Exact error of a + b (Knuth's two-sum)
+double sumError(double a, double b, double sum) {
+    double bPart = sum - a;
+    return (a - (sum - bPart)) + (b - bPart);
+}
+
+double productError(double a, double b, double product) {
+    return std::fma(a, b, -product);
+}
+
+// Sign of a / b - quotient, from the exact remainder
+double quotientError(double a, double b, double quotient) {
+    double remainder = -std::fma(quotient, b, -a);
+    return b > 0 ? remainder : -remainder;
+}
+
+// Enclosure of the runway at one point of (funds, R, S), R and S being fleet totals
+Interval durationAt(double funds, double R, double S) {
+    if (funds == 0) {
+        return Interval(0.0);
+    }
+    if (R <= 0 && S <= 0) {
+        return Interval(INF);
+    }
+    if (R <= 0) {
+        return Interval(funds) / Interval(S) * Interval(24.0);
+    }
+    if (S <= 0) {
+        return Interval(funds) / Interval(R);
+    }
+    return detail::mixedFundsDuration(Interval(funds), Interval(R), Interval(S));
+}
+
+Interval durationBounds(const Interval& initialFunds, const Interval& R, const Interval& S) {
+    return Interval(durationAt(initialFunds.getLower(), R.getUpper(), S.getUpper()).getLower(),
+                    durationAt(initialFunds.getUpper(), R.getLower(), S.getLower()).getUpper());
+}
+
+void validateDurationInputs(const Interval& initialFunds, const Interval& hourlyRate, int numInstances,
+                            const Interval& dailyStorageCost) {
+    if (initialFunds.getLower() < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+    if (hourlyRate.getLower() < 0) {
+        throw std::invalid_argument("Hourly rate can't be negative");
+    }
+    if (dailyStorageCost.getLower() < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+}
+
+// Fleet rows are checked on their lower ends with the fleet calculators' messages
+void validateFleetRow(const IntervalGpuModel& gpu) {
+    if (gpu.getHourlyRate().getLower() < 0) {
+        throw std::invalid_argument("GPU hourly rate can't be negative");
+    }
+    if (gpu.getDailyStorageCost().getLower() < 0) {
+        throw std::invalid_argument("GPU daily storage cost can't be negative");
+    }
+    if (gpu.getNumInstances() <= 0) {
+        throw std::invalid_argument("GPU instance count must be positive");
+    }
+}
+
+} // namespace
+
+Interval::Interval(double value) : lower(value), upper(value) {
+}
+
+Interval::Interval(double lower, double upper) : lower(lower), upper(upper) {
+    if (!(lower <= upper)) {
+        throw std::invalid_argument("Interval lower bound can't exceed upper bound");
+    }
+}
+
+double Interval::getLower() const {
+    return lower;
+}
+
+double Interval::getUpper() const {
+    return upper;
+}
+
+bool Interval::contains(double value) const {
+    return lower <= value && value <= upper;
+}
+
+Interval operator+(const Interval& a, const Interval& b) {
+    double lower = a.getLower() + b.getLower();
+    double upper = a.getUpper() + b.getUpper();
+    return Interval(roundedDown(lower, sumError(a.getLower(), b.getLower(), lower)),
+                    roundedUp(upper, sumError(a.getUpper(), b.getUpper(), upper)));
+}
+
+Interval operator-(const Interval& a, const Interval& b) {
+    double lower = a.getLower() - b.getUpper();
+    double upper = a.getUpper() - b.getLower();
+    return Interval(roundedDown(lower, sumError(a.getLower(), -b.getUpper(), lower)),
+                    roundedUp(upper, sumError(a.getUpper(), -b.getLower(), upper)));
+}
+
+Interval operator*(const Interval& a, const Interval& b) {
+    double lower = INF;
+    double upper = -INF;
+    for (double x : {a.getLower(), a.getUpper()}) {
+        for (double y : {b.getLower(), b.getUpper()}) {
+            // 0 * inf is taken as 0: an infinite end is a missing bound, not a value
+            if (x == 0 || y == 0) {
+                lower = std::min(lower, 0.0);
+                upper = std::max(upper, 0.0);
+                continue;
+            }
+            double product = x * y;
+            double error = productError(x, y, product);
+            lower = std::min(lower, roundedDown(product, error));
+            upper = std::max(upper, roundedUp(product, error));
+        }
+    }
+    return Interval(lower, upper);
+}
+
+Interval operator/(const Interval& a, const Interval& b) {
+    if (b.contains(0.0)) {
+        throw std::invalid_argument("Interval divisor can't contain zero");
+    }
+    double lower = INF;
+    double upper = -INF;
+    for (double x : {a.getLower(), a.getUpper()}) {
+        for (double y : {b.getLower(), b.getUpper()}) {
+            double quotient = x / y;
+            double error = std::isinf(y) ? 0.0 : quotientError(x, y, quotient);
+            lower = std::min(lower, roundedDown(quotient, error));
+            upper = std::max(upper, roundedUp(quotient, error));
+        }
+    }
+    return Interval(lower, upper);
+}
+
+Interval ceil(const Interval& x) {
+    return Interval(std::ceil(x.getLower()), std::ceil(x.getUpper()));
+}
+
+Interval min(const Interval& a, const Interval& b) {
+    return Interval(std::min(a.getLower(), b.getLower()), std::min(a.getUpper(), b.getUpper()));
+}
+
+Interval max(const Interval& a, const Interval& b) {
+    return Interval(std::max(a.getLower(), b.getLower()), std::max(a.getUpper(), b.getUpper()));
+}
+
+Interval roundToCents(const Interval& x) {
+    Interval cents = x * Interval(100.0);
+    return Interval(std::round(cents.getLower()), std::round(cents.getUpper())) / Interval(100.0);
+}
+
+IntervalGpuModel::IntervalGpuModel(const std::string& name, const Interval& hourlyRate,
+                                   const Interval& dailyStorageCost, int numInstances)
+    : name(name), hourlyRate(hourlyRate), dailyStorageCost(dailyStorageCost), numInstances(numInstances) {
+}
+
+const std::string& IntervalGpuModel::getName() const {
+    return name;
+}
+
+const Interval& IntervalGpuModel::getHourlyRate() const {
+    return hourlyRate;
+}
+
+const Interval& IntervalGpuModel::getDailyStorageCost() const {
+    return dailyStorageCost;
+}
+
+int IntervalGpuModel::getNumInstances() const {
+    return numInstances;
+}
+
+Interval calculateTotalCost(const Interval& hourlyRate, int numInstances, int runningTimeHours,
+                            const Interval& dailyStorageCost) {
+    // Input validation
+    if (runningTimeHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (dailyStorageCost.getLower() < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+    if (numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+    if (hourlyRate.getLower() < 0) {
+        throw std::invalid_argument("Hourly rate can't be negative");
+    }
+
+    return roundToCents(detail::totalCostBeforeRounding(hourlyRate, numInstances, runningTimeHours, dailyStorageCost));
+}
+
+Interval calculateRemainingFunds(const Interval& initialFunds, const Interval& totalCost) {
+    return initialFunds - totalCost;
+}
+
+Interval calculateRemainingFunds(const Interval& initialFunds, const Interval& hourlyRate, int numInstances,
+                                 int runningTimeHours, const Interval& dailyStorageCost) {
+    // Input validation
+    if (initialFunds.getLower() < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    Interval totalCost = calculateTotalCost(hourlyRate, numInstances, runningTimeHours, dailyStorageCost);
+
+    // The scalar keeps the funds untouched when they can't cover the cost
+    if (initialFunds.getUpper() < totalCost.getLower()) {
+        return initialFunds;
+    }
+    if (initialFunds.getLower() >= totalCost.getUpper()) {
+        return initialFunds - totalCost;
+    }
+    // Either can happen: funds - cost >= 0 when covered, funds when not, never more than the funds
+    return Interval(0.0, initialFunds.getUpper());
+}
+
+Interval calculateFundsDuration(const Interval& initialFunds, const Interval& hourlyRate, int numInstances,
+                                const Interval& dailyStorageCost) {
+    // Input validation
+    validateDurationInputs(initialFunds, hourlyRate, numInstances, dailyStorageCost);
+
+    Interval instances((double)(numInstances));
+    return durationBounds(initialFunds, hourlyRate * instances, dailyStorageCost * instances);
+}
+
+Interval calculateTotalCostMultipleGpus(const std::vector<IntervalGpuModel>& gpuModels, int runningHours) {
+    // Input validation
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    for (const auto& gpu : gpuModels) {
+        validateFleetRow(gpu);
+    }
+
+    Interval totalCost(0.0);
+    for (const auto& gpu : gpuModels) {
+        totalCost = totalCost + calculateTotalCost(gpu.getHourlyRate(), gpu.getNumInstances(), runningHours,
+                                                   gpu.getDailyStorageCost());
+    }
+    return totalCost;
+}
+
+Interval calculateFundsDurationMultipleGpus(const Interval& initialFunds, const std::vector<IntervalGpuModel>& gpuModels) {
+    // Input validation
+    if (initialFunds.getLower() < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+
+    Interval totalHourlyRate(0.0);
+    Interval totalDailyStorageCost(0.0);
+    for (const auto& gpu : gpuModels) {
+        validateFleetRow(gpu);
+        Interval instances((double)(gpu.getNumInstances()));
+        totalHourlyRate = totalHourlyRate + gpu.getHourlyRate() * instances;
+        totalDailyStorageCost = totalDailyStorageCost + gpu.getDailyStorageCost() * instances;
+    }
+
+    return durationBounds(initialFunds, totalHourlyRate, totalDailyStorageCost);
+}
+
+void calculateFundsDurationBatch(const Interval* initialFunds, const Interval* hourlyRates, const int* instanceCounts,
+                                 const Interval* dailyStorageCosts, std::size_t count, Interval* durations) {
+    // Input validation
+    for (std::size_t i = 0; i < count; i++) {
+        validateDurationInputs(initialFunds[i], hourlyRates[i], instanceCounts[i], dailyStorageCosts[i]);
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        Interval instances((double)(instanceCounts[i]));
+        durations[i] = durationBounds(initialFunds[i], hourlyRates[i] * instances, dailyStorageCosts[i] * instances);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Closed interval [lower, upper] of real numbers. Operations round the lower end down and the
+// upper end up (by one ulp, only when the floating point result is inexact), so a result always
+// contains the exact real result of the operation on any values from the operands. Infinite
+// ends are allowed.
+class Interval {
+public:
+    // The single value [value, value]
+    Interval(double value = 0.0);
+    Interval(double lower, double upper);
+
+    double getLower() const;
+    double getUpper() const;
+    bool contains(double value) const;
+
+private:
+    double lower;
+    double upper;
+};
+
+Interval operator+(const Interval& a, const Interval& b);
+Interval operator-(const Interval& a, const Interval& b);
+Interval operator*(const Interval& a, const Interval& b);
+// The divisor can't contain zero
+Interval operator/(const Interval& a, const Interval& b);
+
+Interval ceil(const Interval& x);
+Interval min(const Interval& a, const Interval& b);
+Interval max(const Interval& a, const Interval& b);
+// Round both ends to cents as calculateTotalCost does, keeping the result an enclosure
+Interval roundToCents(const Interval& x);
+
+// A GpuModel whose rate and storage cost are only known to lie in an interval
+class IntervalGpuModel {
+public:
+    /**
+     * @param name The name of the GPU model
+     * @param hourlyRate Range of the hourly rate
+     * @param dailyStorageCost Range of the daily storage cost
+     * @param numInstances The number of instances
+     */
+    IntervalGpuModel(const std::string& name, const Interval& hourlyRate, const Interval& dailyStorageCost,
+                     int numInstances = 1);
+
+    const std::string& getName() const;
+    const Interval& getHourlyRate() const;
+    const Interval& getDailyStorageCost() const;
+    int getNumInstances() const;
+
+private:
+    std::string name;
+    Interval hourlyRate;
+    Interval dailyStorageCost;
+    int numInstances;
+};
+
+// Guaranteed bounds on the calculators over every input in the given intervals, from one
+// evaluation each. Input validation applies to the lower ends with the scalar messages.
+//
+// Cost is evaluated with the same templated formula as calculateTotalCost. Runway is monotone
+// (up in funds, down in rate and storage), so its bounds are the calculateFundsDuration closed
+// form evaluated in interval arithmetic at the two extreme corners. An upper bound of infinity
+// stands for the scalar's -1 (funds never run out).
+Interval calculateTotalCost(const Interval& hourlyRate, int numInstances, int runningTimeHours,
+                            const Interval& dailyStorageCost);
+
+Interval calculateRemainingFunds(const Interval& initialFunds, const Interval& totalCost);
+
+Interval calculateRemainingFunds(const Interval& initialFunds, const Interval& hourlyRate, int numInstances,
+                                 int runningTimeHours, const Interval& dailyStorageCost);
+
+Interval calculateFundsDuration(const Interval& initialFunds, const Interval& hourlyRate, int numInstances,
+                                const Interval& dailyStorageCost);
+
+Interval calculateTotalCostMultipleGpus(const std::vector<IntervalGpuModel>& gpuModels, int runningHours);
+
+Interval calculateFundsDurationMultipleGpus(const Interval& initialFunds, const std::vector<IntervalGpuModel>& gpuModels);
+
+// Runway bounds for many configurations, durations[i] being
+//     calculateFundsDuration(initialFunds[i], hourlyRates[i], instanceCounts[i], dailyStorageCosts[i])
+void calculateFundsDurationBatch(const Interval* initialFunds, const Interval* hourlyRates, const int* instanceCounts,
+                                 const Interval* dailyStorageCosts, std::size_t count, Interval* durations);
@@ -0,0 +1,181 @@
+#include "kernel_profiler.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+const char* const COUNTER_NAMES[HARDWARE_COUNTER_COUNT] = {"cycles", "instr", "br-miss", "L1d-miss", "LLC-miss"};
+
+int openCounter(HardwareCounter counter) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Count the threads parallelForChunks spawns too; their counts fold into ours when they're joined
+    attr.inherit = 1;
+    // Five events rarely fit the PMU at once; the enabled and running times let stop() scale
+    // what each counter saw while multiplexed
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (counter) {
+    case HardwareCounter::Cycles:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case HardwareCounter::Instructions:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case HardwareCounter::BranchMisses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case HardwareCounter::L1dMisses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case HardwareCounter::LlcMisses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    }
+    return (int)(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+std::int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+std::uint64_t scaleMultiplexedCount(std::uint64_t value, std::uint64_t timeEnabled, std::uint64_t timeRunning) {
+    if (timeRunning == 0) {
+        return 0;
+    }
+    if (timeRunning >= timeEnabled) {
+        return value;
+    }
+    return (std::uint64_t)((double)(value) * (double)(timeEnabled) / (double)(timeRunning) + 0.5);
+}
+
+KernelProfiler::KernelProfiler(bool useCounters) {
+    for (std::size_t c = 0; c < HARDWARE_COUNTER_COUNT; c++) {
+        fds[c] = useCounters ? openCounter((HardwareCounter)(c)) : -1;
+    }
+}
+
+KernelProfiler::~KernelProfiler() {
+    for (int fd : fds) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+bool KernelProfiler::isCounterAvailable(HardwareCounter counter) const {
+    return fds[(std::size_t)(counter)] >= 0;
+}
+
+bool KernelProfiler::hasAnyCounters() const {
+    for (int fd : fds) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void KernelProfiler::start() {
+    for (int fd : fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    startNanos = nowNanos();
+}
+
+void KernelProfiler::stop(const std::string& name, std::uint64_t calls) {
+    std::int64_t elapsed = nowNanos() - startNanos;
+    KernelProfile& profile = profiles[name];
+    for (std::size_t c = 0; c < HARDWARE_COUNTER_COUNT; c++) {
+        if (fds[c] < 0) {
+            continue;
+        }
+        ioctl(fds[c], PERF_EVENT_IOC_DISABLE, 0);
+        // value, time enabled, time running
+        std::uint64_t reading[3] = {0, 0, 0};
+        if (::read(fds[c], reading, sizeof(reading)) == (ssize_t)(sizeof(reading))) {
+            profile.counters[c] += scaleMultiplexedCount(reading[0], reading[1], reading[2]);
+            if (reading[2] < reading[1]) {
+                profile.scaled[c] = true;
+            }
+        }
+    }
+    profile.calls += calls;
+    profile.seconds += (double)(elapsed) / 1e9;
+}
+
+const std::map<std::string, KernelProfile>& KernelProfiler::getProfiles() const {
+    return profiles;
+}
+
+void KernelProfiler::printReport(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "\nKernel profile (per call):" << std::endl;
+    out << std::left << std::setw(38) << "Kernel" << std::right << std::setw(12) << "Calls"
+        << std::setw(12) << "ns";
+    for (const char* counter : COUNTER_NAMES) {
+        out << std::setw(12) << counter;
+    }
+    out << std::setw(8) << "IPC" << std::endl;
+    out << std::string(38 + 12 * 7 + 8, '-') << std::endl;
+
+    out << std::fixed;
+    bool anyScaled = false;
+    for (const auto& entry : profiles) {
+        const KernelProfile& profile = entry.second;
+        double calls = profile.calls == 0 ? 1.0 : (double)(profile.calls);
+        out << std::left << std::setw(38) << entry.first << std::right << std::setw(12) << profile.calls
+            << std::setprecision(1) << std::setw(12) << profile.seconds * 1e9 / calls;
+        for (std::size_t c = 0; c < HARDWARE_COUNTER_COUNT; c++) {
+            if (fds[c] < 0) {
+                out << std::setw(12) << "n/a";
+            } else if (profile.scaled[c]) {
+                out << std::setw(11) << (double)(profile.counters[c]) / calls << '*';
+                anyScaled = true;
+            } else {
+                out << std::setw(12) << (double)(profile.counters[c]) / calls;
+            }
+        }
+        std::uint64_t cycles = profile.counters[(std::size_t)(HardwareCounter::Cycles)];
+        std::uint64_t instructions = profile.counters[(std::size_t)(HardwareCounter::Instructions)];
+        if (cycles > 0 && isCounterAvailable(HardwareCounter::Instructions)) {
+            out << std::setprecision(2) << std::setw(8) << (double)(instructions) / (double)(cycles);
+        } else {
+            out << std::setw(8) << "n/a";
+        }
+        out << std::endl;
+    }
+    if (anyScaled) {
+        out << "(* counter was multiplexed; value scaled from the time it was counting)" << std::endl;
+    }
+    if (!hasAnyCounters()) {
+        out << "(hardware counters unavailable; clock timing only - check /proc/sys/kernel/perf_event_paranoid)"
+            << std::endl;
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+enum class HardwareCounter { Cycles, Instructions, BranchMisses, L1dMisses, LlcMisses };
+
+const std::size_t HARDWARE_COUNTER_COUNT = 5;
+
+// Totals for one profiled kernel. Counters that could not be opened stay at zero and are
+// reported as unavailable.
+struct KernelProfile {
+    std::uint64_t calls = 0;
+    double seconds = 0.0;
+    std::array<std::uint64_t, HARDWARE_COUNTER_COUNT> counters{};
+    // Set when a counter shared the PMU with others during some measurement, so its total is
+    // extrapolated from the time it was actually counting
+    std::array<bool, HARDWARE_COUNTER_COUNT> scaled{};
+};
+
+// A multiplexed counter's raw value extrapolated to the whole enabled time, as perf stat does:
+// value * timeEnabled / timeRunning. A counter that never ran gives 0.
+std::uint64_t scaleMultiplexedCount(std::uint64_t value, std::uint64_t timeEnabled, std::uint64_t timeRunning);
+
+// Times calculator kernels with perf_event_open counters (user-space cycles, instructions,
+// branch misses, L1D read misses and last-level cache misses).
+// Counters follow threads started while they're open, so parallel kernels are counted in full.
+// Each counter is opened on its own, so the profiler keeps whatever the kernel permits; when
+// perf_event_paranoid or a container forbids all of them it falls back to wall-clock timing.
+class KernelProfiler {
+public:
+    /**
+     * @param useCounters Open hardware counters; false gives clock-only timing
+     */
+    explicit KernelProfiler(bool useCounters = true);
+    ~KernelProfiler();
+
+    KernelProfiler(const KernelProfiler&) = delete;
+    KernelProfiler& operator=(const KernelProfiler&) = delete;
+
+    // Run fn once under the counters and add the result to name's totals as `calls` calls,
+    // so a loop of many small calls is measured once and reported per call
+    template <typename Fn>
+    void measure(const std::string& name, std::uint64_t calls, Fn&& fn) {
+        start();
+        fn();
+        stop(name, calls);
+    }
+
+    bool isCounterAvailable(HardwareCounter counter) const;
+    bool hasAnyCounters() const;
+
+    const std::map<std::string, KernelProfile>& getProfiles() const;
+
+    // Per-call averages (ns, cycles, instructions, IPC, misses), one row per kernel
+    void printReport(std::ostream& out) const;
+
+private:
+    void start();
+    void stop(const std::string& name, std::uint64_t calls);
+
+    std::array<int, HARDWARE_COUNTER_COUNT> fds;
+    std::map<std::string, KernelProfile> profiles;
+    std::int64_t startNanos = 0;
+};
@@ -1,13 +1,24 @@
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 #include <string>
 #include <vector>
+#include "bulk_pipeline.h"
+#include "fleet_aggregation.h"
 #include "funds_calculator.h"
 #include "gpu_model.h"
+#include "kernel_profiler.h"
+#include "trace.h"
+#include "tracker_snapshot.h"
+#include "usage_log_watch.h"
+
+static TrackerState promptForState() {
+    TRACE_SCOPE("input parsing");
 
-int main() {
-    std::cout << "VastGPU Funds Tracker\n\n";
-    
     double initialFunds;
     std::cout << "Enter initial funds: $";
     std::cin >> initialFunds;
@@ -67,6 +78,7 @@ int main() {
             std::cin >> instances;
         }
         
+        TRACE_SCOPE("fleet construction");
         GpuModel model(name, hourlyRate, dailyStorageCost, instances);
         gpuModels.push_back(model);
     }
@@ -80,39 +92,68 @@ int main() {
         std::cout << "Invalid input. Please enter a non-negative value: ";
         std::cin >> runningTimeHours;
     }
-    
-    double totalCost = calculateTotalCostMultipleGpus(gpuModels, runningTimeHours);
+
+    TrackerState state;
+    state.initialFunds = initialFunds;
+    state.runningTimeHours = runningTimeHours;
+    state.gpuModels = std::move(gpuModels);
+    return state;
+}
+
+// Set by --profile; calculator calls made through profiled() are timed and counted.
+// They are also traced as spans of the same name.
+static KernelProfiler* profiler = nullptr;
+
+template <typename Fn>
+static auto profiled(const char* name, Fn fn) {
+    TRACE_SCOPE(name);
+    if (profiler == nullptr) {
+        return fn();
+    }
+    decltype(fn()) result{};
+    profiler->measure(name, 1, [&]() { result = fn(); });
+    return result;
+}
+
+static void printReport(const TrackerState& state) {
+    double initialFunds = state.initialFunds;
+    int runningTimeHours = state.runningTimeHours;
+    const std::vector<GpuModel>& gpuModels = state.gpuModels;
+
+    TRACE_SCOPE("report");
+    double totalCost = profiled("calculateTotalCostMultipleGpus",
+                                [&]() { return calculateTotalCostMultipleGpus(gpuModels, runningTimeHours); });
     double remainingFunds = calculateRemainingFunds(initialFunds, totalCost);
-    double fundsDuration = calculateFundsDurationMultipleGpus(initialFunds, gpuModels);
+    double fundsDuration = profiled("calculateFundsDurationMultipleGpus",
+                                    [&]() { return calculateFundsDurationMultipleGpus(initialFunds, gpuModels); });
     
     std::cout << "\n================ RESULTS =================" << std::endl;
     std::cout << std::fixed << std::setprecision(2);
     
 
+    FleetAggregateReport report = profiled("aggregateFleetByModel",
+                                           [&]() { return aggregateFleetByModel(gpuModels, runningTimeHours); });
+
+    TRACE_SCOPE("report formatting");
+
     std::cout << "\nCosts by GPU model:" << std::endl;
     std::cout << std::setw(15) << "GPU Model" << std::setw(10) << "Instances" 
-              << std::setw(15) << "Hourly Rate" << std::setw(15) << "Storage Cost" 
-              << std::setw(15) << "Total Cost" << std::endl;
-    std::cout << std::string(70, '-') << std::endl;
+              << std::setw(15) << "Runtime Cost" << std::setw(15) << "Storage Cost" 
+              << std::setw(15) << "Total Cost" << std::setw(15) << "Burn Share" << std::endl;
+    std::cout << std::string(85, '-') << std::endl;
     
-    for (const auto& gpu : gpuModels) {
-        double modelCost = calculateTotalCost(gpu.getHourlyRate(), gpu.getNumInstances(), 
-                                            runningTimeHours, gpu.getDailyStorageCost());
-        std::cout << std::setw(15) << gpu.getName() 
-                  << std::setw(10) << gpu.getNumInstances()
-                  << std::setw(15) << "$" << gpu.getHourlyRate()
-                  << std::setw(15) << "$" << gpu.getDailyStorageCost()
-                  << std::setw(15) << "$" << modelCost << std::endl;
+    for (const auto& model : report.models) {
+        std::cout << std::setw(15) << model.name 
+                  << std::setw(10) << model.instances
+                  << std::setw(15) << "$" << model.runtimeCost
+                  << std::setw(15) << "$" << model.storageCost
+                  << std::setw(15) << "$" << model.totalCost
+                  << std::setw(14) << model.burnShare * 100.0 << "%" << std::endl;
     }
     
     std::cout << "\nSummary:" << std::endl;
     
-    int totalInstances = 0;
-    for (const auto& gpu : gpuModels) {
-        totalInstances += gpu.getNumInstances();
-    }
-    
-    std::cout << "Total instances: " << totalInstances << std::endl;
+    std::cout << "Total instances: " << report.totalInstances << std::endl;
     std::cout << "Total cost for " << runningTimeHours << " hours: $" << totalCost << std::endl;
     std::cout << "Initial funds: $" << initialFunds << std::endl;
     
@@ -131,6 +172,193 @@ int main() {
     }
     
     std::cout << "=========================================" << std::endl;
+}
+
+static void printUsage() {
+    std::cerr << "Usage: vastgpu_tracker [--profile] [--save-snapshot <file>]\n"
+              << "       vastgpu_tracker [--profile] --restore-snapshot <file>\n"
+              << "       vastgpu_tracker [--profile] --bulk <hours> [--queue-depth <batches>] [--batch-size <rows>]\n"
+              << "       vastgpu_tracker --watch <usage.log> --funds <amount>\n"
+              << "\n"
+              << "  --profile                  Report time and hardware counters per calculator call on stderr\n"
+              << "  --trace <file.json>        Write a Chrome trace of spans and allocations (needs a build\n"
+              << "                             configured with -DVASTGPU_TRACING=ON)\n"
+              << "  --save-snapshot <file>     After the prompts, save funds and fleet to a binary snapshot\n"
+              << "  --restore-snapshot <file>  Skip the prompts and report from a saved snapshot\n"
+              << "  --bulk <hours>             Read name,hourlyRate,dailyStorageCost,numInstances rows from stdin\n"
+              << "                             and write name,numInstances,totalCost rows to stdout\n"
+              << "  --watch <usage.log>        Follow a log of name,hourlyRate,dailyStorageCost,numInstances,hours\n"
+              << "                             charges and print remaining funds and runway as it grows\n";
+}
+
+static bool parseCount(const std::string& text, long& value) {
+    char* end = nullptr;
+    value = std::strtol(text.c_str(), &end, 10);
+    return end != text.c_str() && *end == '\0' && value >= 0;
+}
+
+static int runInteractive(const std::string& savePath) {
+    std::cout << "VastGPU Funds Tracker\n\n";
+    TrackerState state = promptForState();
+    printReport(state);
+
+    if (!savePath.empty()) {
+        saveSnapshot(savePath, state);
+        std::cout << "Snapshot saved to " << savePath << std::endl;
+    }
+    return 0;
+}
+
+static int runRestored(const std::string& restorePath) {
+    TrackerState state;
+    {
+        TRACE_SCOPE("snapshot restore");
+        SnapshotView snapshot(restorePath);
+        state = snapshot.toState();
+    }
+    std::cout << "VastGPU Funds Tracker (restored from " << restorePath << ")" << std::endl;
+    printReport(state);
+    return 0;
+}
+
+static std::atomic<bool> stopWatching(false);
 
+static void handleStopSignal(int) {
+    stopWatching.store(true);
+}
+
+static int runWatch(const std::string& logPath, double initialFunds) {
+    UsageLogFollower follower(logPath, initialFunds);
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Watching " << logPath << " (Ctrl-C to stop)" << std::endl;
+    watchUsageLog(follower, [](const UsageLogFollower& state) {
+        std::cout << "records: " << state.getRecordCount()
+                  << "  charged: $" << state.getTotalCharged()
+                  << "  remaining: $" << state.getRemainingFunds();
+        double runway = state.getProjectedRunway();
+        if (runway == -1) {
+            std::cout << "  runway: indefinite";
+        } else {
+            std::cout << "  runway: " << runway << " hours";
+        }
+        if (state.getErrorCount() > 0) {
+            std::cout << "  invalid lines: " << state.getErrorCount() << " (" << state.getLastError() << ")";
+        }
+        std::cout << std::endl;
+    }, stopWatching);
     return 0;
-}
\ No newline at end of file
+}
+
+static int runBulk(const PipelineConfig& config) {
+    std::ios::sync_with_stdio(false);
+    PipelineStats stats = profiled("runBulkPipeline",
+                                   [&]() { return runBulkPipeline(std::cin, std::cout, std::cerr, config); });
+
+    std::cerr << std::fixed << std::setprecision(0)
+              << "parse:  " << stats.parse.items << " rows, " << stats.parse.itemsPerSecond() << " rows/s\n"
+              << "price:  " << stats.price.items << " rows, " << stats.price.itemsPerSecond() << " rows/s\n"
+              << "format: " << stats.format.items << " rows, " << stats.format.itemsPerSecond() << " rows/s\n"
+              << std::setprecision(3)
+              << "invalid rows: " << stats.errorRows << ", wall time: " << stats.wallSeconds << " s" << std::endl;
+    return stats.errorRows == 0 ? 0 : 2;
+}
+
+int main(int argc, char** argv) {
+    PipelineConfig config;
+    bool bulk = false;
+    std::string savePath;
+    std::string restorePath;
+    std::string watchPath;
+    double watchFunds = -1.0;
+    bool profile = false;
+    std::string tracePath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--profile") {
+            profile = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        long count = 0;
+
+        if (arg == "--bulk" && parseCount(value, count)) {
+            bulk = true;
+            config.runningHours = (int)(count);
+        } else if (arg == "--queue-depth" && parseCount(value, count) && count > 0) {
+            config.queueDepth = (std::size_t)(count);
+        } else if (arg == "--batch-size" && parseCount(value, count) && count > 0) {
+            config.batchSize = (std::size_t)(count);
+        } else if (arg == "--save-snapshot") {
+            savePath = value;
+        } else if (arg == "--restore-snapshot") {
+            restorePath = value;
+        } else if (arg == "--trace") {
+            tracePath = value;
+        } else if (arg == "--watch") {
+            watchPath = value;
+        } else if (arg == "--funds") {
+            char* end = nullptr;
+            watchFunds = std::strtod(value.c_str(), &end);
+            if (end == value.c_str() || *end != '\0' || !(watchFunds >= 0.0)) {
+                printUsage();
+                return 1;
+            }
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!watchPath.empty() && watchFunds < 0) {
+        printUsage();
+        return 1;
+    }
+
+#ifndef VASTGPU_TRACING
+    if (!tracePath.empty()) {
+        std::cerr << "Error: tracing is not compiled in; configure with -DVASTGPU_TRACING=ON" << std::endl;
+        return 1;
+    }
+#endif
+    setTracingEnabled(!tracePath.empty());
+
+    KernelProfiler kernelProfiler(profile);
+    if (profile) {
+        profiler = &kernelProfiler;
+    }
+
+    try {
+        int status;
+        if (!watchPath.empty()) {
+            status = runWatch(watchPath, watchFunds);
+        } else if (bulk) {
+            status = runBulk(config);
+        } else if (!restorePath.empty()) {
+            status = runRestored(restorePath);
+        } else {
+            status = runInteractive(savePath);
+        }
+        if (profile) {
+            kernelProfiler.printReport(std::cerr);
+        }
+        if (!tracePath.empty()) {
+            std::ofstream traceFile(tracePath);
+            writeChromeTrace(traceFile);
+            if (!traceFile) {
+                throw std::runtime_error("can't write trace to " + tracePath);
+            }
+        }
+        return status;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
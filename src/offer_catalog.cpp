@@ -0,0 +1,210 @@
+#include "offer_catalog.h"
+#include "funds_calculator.h"
+#include "parallel.h"
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+
+namespace {
+
+const std::size_t BUILD_CHUNK_SIZE = 1 << 16;
+
+// Ties on rate are broken by catalog position so every build yields the same order
+bool cheaperEntry(const OfferEntry& a, const OfferEntry& b) {
+    if (a.effectiveHourlyRate != b.effectiveHourlyRate) {
+        return a.effectiveHourlyRate < b.effectiveHourlyRate;
+    }
+    return a.offerIndex < b.offerIndex;
+}
+
+bool cheaperQuote(const OfferQuote& a, const OfferQuote& b) {
+    if (a.totalCost != b.totalCost) {
+        return a.totalCost < b.totalCost;
+    }
+    return a.offerIndex < b.offerIndex;
+}
+
+// Sort fixed-size runs in parallel, then merge neighbouring runs level by level
+void parallelSort(std::vector<OfferEntry>& entries, unsigned threadCount) {
+    std::size_t count = entries.size();
+    parallelForChunks(count, BUILD_CHUNK_SIZE, threadCount, [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::sort(entries.begin() + begin, entries.begin() + end, cheaperEntry);
+    });
+
+    for (std::size_t width = BUILD_CHUNK_SIZE; width < count; width *= 2) {
+        std::size_t pairs = (count + 2 * width - 1) / (2 * width);
+        parallelForChunks(pairs, 1, threadCount, [&](std::size_t pair, std::size_t, std::size_t) {
+            std::size_t begin = pair * 2 * width;
+            std::size_t middle = std::min(count, begin + width);
+            std::size_t end = std::min(count, begin + 2 * width);
+            std::inplace_merge(entries.begin() + begin, entries.begin() + middle,
+                               entries.begin() + end, cheaperEntry);
+        });
+    }
+}
+
+} // namespace
+
+OfferCatalog::OfferCatalog(const std::vector<GpuModel>& offers, unsigned threadCount) {
+    std::size_t count = offers.size();
+    allOffers.resize(count);
+
+    // Each chunk stops at its first invalid row; the first one in catalog order decides the
+    // error, so the message doesn't depend on which thread found it
+    std::size_t chunkCount = (count + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE;
+    std::vector<std::size_t> chunkInvalidRow(chunkCount, count);
+    parallelForChunks(count, BUILD_CHUNK_SIZE, threadCount, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        for (std::size_t i = begin; i < end; i++) {
+            const GpuModel& gpu = offers[i];
+            if (!detail::isValidFleetRow(gpu)) {
+                chunkInvalidRow[chunk] = i;
+                return;
+            }
+            allOffers[i] = OfferEntry{gpu.getHourlyRate() + gpu.getDailyStorageCost() / 24.0,
+                                      gpu.getHourlyRate(), gpu.getDailyStorageCost(),
+                                      gpu.getNumInstances(), i};
+        }
+    });
+    for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+        if (chunkInvalidRow[chunk] != count) {
+            detail::validateFleetRow(offers[chunkInvalidRow[chunk]]);
+        }
+    }
+
+    // Partition by name in catalog order; names are assigned ids on first appearance
+    std::vector<std::size_t> partitionOf(count);
+    for (std::size_t i = 0; i < count; i++) {
+        auto inserted = partitionByName.emplace(offers[i].getName(), partitionNames.size());
+        if (inserted.second) {
+            partitionNames.push_back(offers[i].getName());
+        }
+        partitionOf[i] = inserted.first->second;
+    }
+
+    std::vector<std::size_t> partitionSizes(partitionNames.size(), 0);
+    for (std::size_t i = 0; i < count; i++) {
+        partitionSizes[partitionOf[i]]++;
+    }
+    partitions.resize(partitionNames.size());
+    for (std::size_t p = 0; p < partitions.size(); p++) {
+        partitions[p].reserve(partitionSizes[p]);
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        partitions[partitionOf[i]].push_back(allOffers[i]);
+    }
+
+    parallelForChunks(partitions.size(), 1, threadCount, [&](std::size_t p, std::size_t, std::size_t) {
+        std::sort(partitions[p].begin(), partitions[p].end(), cheaperEntry);
+    });
+    parallelSort(allOffers, threadCount);
+}
+
+std::size_t OfferCatalog::size() const {
+    return allOffers.size();
+}
+
+std::vector<std::string> OfferCatalog::getModelNames() const {
+    return partitionNames;
+}
+
+std::vector<OfferQuote> OfferCatalog::cheapest(std::size_t k, int runningHours, int numInstances) const {
+    return cheapestIn(allOffers, k, runningHours, numInstances);
+}
+
+std::vector<OfferQuote> OfferCatalog::cheapest(const std::string& name, std::size_t k,
+                                               int runningHours, int numInstances) const {
+    const std::vector<OfferEntry>* partition = findPartition(name);
+    if (partition == nullptr) {
+        return {};
+    }
+    return cheapestIn(*partition, k, runningHours, numInstances);
+}
+
+std::vector<std::size_t> OfferCatalog::inPriceRange(double minRate, double maxRate) const {
+    return rangeIn(allOffers, minRate, maxRate);
+}
+
+std::vector<std::size_t> OfferCatalog::inPriceRange(const std::string& name, double minRate, double maxRate) const {
+    const std::vector<OfferEntry>* partition = findPartition(name);
+    if (partition == nullptr) {
+        return {};
+    }
+    return rangeIn(*partition, minRate, maxRate);
+}
+
+std::vector<OfferQuote> OfferCatalog::cheapestIn(const std::vector<OfferEntry>& entries, std::size_t k,
+                                                 int runningHours, int numInstances) const {
+    // Input validation
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+
+    std::vector<OfferQuote> best;
+    if (k == 0) {
+        return best;
+    }
+
+    // Max-heap of the k cheapest quotes seen so far
+    std::priority_queue<OfferQuote, std::vector<OfferQuote>, decltype(&cheaperQuote)> heap(cheaperQuote);
+
+    // Storage is billed per started day, so the exact cost is never below
+    // numInstances * runningHours * effectiveHourlyRate. Once that lower bound
+    // passes the k-th best cost no later entry can enter the result.
+    // The half cent allows for calculateTotalCost rounding down.
+    double hoursTimesInstances = (double)(runningHours) * (double)(numInstances);
+    for (const auto& entry : entries) {
+        if (heap.size() == k && hoursTimesInstances * entry.effectiveHourlyRate - 0.005 > heap.top().totalCost) {
+            break;
+        }
+        if (entry.numInstances < numInstances) {
+            continue;
+        }
+
+        OfferQuote quote{entry.offerIndex, calculateTotalCost(entry.hourlyRate, numInstances,
+                                                              runningHours, entry.dailyStorageCost)};
+        if (heap.size() < k) {
+            heap.push(quote);
+        } else if (cheaperQuote(quote, heap.top())) {
+            heap.pop();
+            heap.push(quote);
+        }
+    }
+
+    best.reserve(heap.size());
+    while (!heap.empty()) {
+        best.push_back(heap.top());
+        heap.pop();
+    }
+    std::reverse(best.begin(), best.end());
+    return best;
+}
+
+std::vector<std::size_t> OfferCatalog::rangeIn(const std::vector<OfferEntry>& entries,
+                                               double minRate, double maxRate) const {
+    std::vector<std::size_t> result;
+    if (minRate > maxRate) {
+        return result;
+    }
+
+    auto first = std::lower_bound(entries.begin(), entries.end(), minRate,
+                                  [](const OfferEntry& entry, double rate) { return entry.effectiveHourlyRate < rate; });
+    auto last = std::upper_bound(first, entries.end(), maxRate,
+                                 [](double rate, const OfferEntry& entry) { return rate < entry.effectiveHourlyRate; });
+
+    result.reserve(last - first);
+    for (auto it = first; it != last; ++it) {
+        result.push_back(it->offerIndex);
+    }
+    return result;
+}
+
+const std::vector<OfferEntry>* OfferCatalog::findPartition(const std::string& name) const {
+    auto found = partitionByName.find(name);
+    if (found == partitionByName.end()) {
+        return nullptr;
+    }
+    return &partitions[found->second];
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One offer row as stored in the index.
+// effectiveHourlyRate is hourlyRate plus dailyStorageCost amortised over 24 hours.
+struct OfferEntry {
+    double effectiveHourlyRate;
+    double hourlyRate;
+    double dailyStorageCost;
+    int numInstances;
+    std::size_t offerIndex;
+};
+
+// Result of a cheapest-configuration query; offerIndex points into the source catalog
+struct OfferQuote {
+    std::size_t offerIndex;
+    double totalCost;
+};
+
+// Read-only index over a catalog of GpuModel offers.
+// Offers are kept in arrays sorted by effective hourly rate, one per model name plus one
+// for the whole catalog, so cheapest-k and price-range queries only touch a prefix or a
+// slice of an array instead of pricing every offer.
+class OfferCatalog {
+public:
+    /**
+     * Build the index. Sorting runs on threadCount threads (0 = hardware concurrency).
+     *
+     * @param offers Catalog rows; an offer's numInstances is the number of instances it can supply
+     * @param threadCount Number of threads used for the build
+     */
+    explicit OfferCatalog(const std::vector<GpuModel>& offers, unsigned threadCount = 0);
+
+    std::size_t size() const;
+    std::vector<std::string> getModelNames() const;
+
+    // k cheapest offers for running numInstances instances for runningHours hours.
+    // Costs match calculateTotalCost exactly; offers with fewer than numInstances instances are skipped.
+    std::vector<OfferQuote> cheapest(std::size_t k, int runningHours, int numInstances) const;
+    std::vector<OfferQuote> cheapest(const std::string& name, std::size_t k, int runningHours, int numInstances) const;
+
+    // Offers whose effective hourly rate lies in [minRate, maxRate], cheapest first
+    std::vector<std::size_t> inPriceRange(double minRate, double maxRate) const;
+    std::vector<std::size_t> inPriceRange(const std::string& name, double minRate, double maxRate) const;
+
+private:
+    std::vector<OfferQuote> cheapestIn(const std::vector<OfferEntry>& entries, std::size_t k,
+                                       int runningHours, int numInstances) const;
+    std::vector<std::size_t> rangeIn(const std::vector<OfferEntry>& entries, double minRate, double maxRate) const;
+    const std::vector<OfferEntry>* findPartition(const std::string& name) const;
+
+    std::vector<OfferEntry> allOffers;
+    std::vector<std::string> partitionNames;
+    std::vector<std::vector<OfferEntry>> partitions;
+    std::unordered_map<std::string, std::size_t> partitionByName;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of worker threads to use when the caller passes 0
+inline unsigned defaultThreadCount() {
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
+
+// Split [0, count) into fixed-size chunks and run fn(begin, end, chunkIndex) for each chunk.
+// Chunk boundaries depend only on count and chunkSize, never on the thread count, so
+// callers that combine per-chunk results in chunk order get the same answer on any machine.
+// The first exception thrown by a chunk is rethrown on the calling thread.
+template <typename Fn>
+void parallelForChunks(std::size_t count, std::size_t chunkSize, unsigned threadCount, Fn fn) {
+    if (count == 0) {
+        return;
+    }
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+    if (threadCount == 0) {
+        threadCount = defaultThreadCount();
+    }
+
+    std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    std::size_t workers = std::min<std::size_t>(threadCount, chunkCount);
+
+    auto runChunk = [&](std::size_t chunk) {
+        std::size_t begin = chunk * chunkSize;
+        std::size_t end = std::min(count, begin + chunkSize);
+        fn(begin, end, chunk);
+    };
+
+    if (workers <= 1) {
+        for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+            runChunk(chunk);
+        }
+        return;
+    }
+
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    // Static round-robin assignment keeps the helper free of shared counters
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (std::size_t w = 0; w < workers; w++) {
+        pool.emplace_back([&, w]() {
+            try {
+                for (std::size_t chunk = w; chunk < chunkCount; chunk += workers) {
+                    runChunk(chunk);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
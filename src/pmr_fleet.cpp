@@ -0,0 +1,74 @@
+#include "pmr_fleet.h"
+
+PmrGpuModel::PmrGpuModel(std::string_view name, double hourlyRate, double dailyStorageCost, int numInstances,
+                         const allocator_type& alloc)
+    : name(name, alloc), hourlyRate(hourlyRate), dailyStorageCost(dailyStorageCost), numInstances(numInstances) {
+}
+
+PmrGpuModel::PmrGpuModel(const allocator_type& alloc)
+    : name("Default", alloc), hourlyRate(0.0), dailyStorageCost(0.0), numInstances(1) {
+}
+
+PmrGpuModel::PmrGpuModel(const PmrGpuModel& other, const allocator_type& alloc)
+    : name(other.name, alloc), hourlyRate(other.hourlyRate), dailyStorageCost(other.dailyStorageCost),
+      numInstances(other.numInstances) {
+}
+
+PmrGpuModel::PmrGpuModel(PmrGpuModel&& other, const allocator_type& alloc)
+    : name(std::move(other.name), alloc), hourlyRate(other.hourlyRate), dailyStorageCost(other.dailyStorageCost),
+      numInstances(other.numInstances) {
+}
+
+const std::pmr::string& PmrGpuModel::getName() const {
+    return name;
+}
+
+double PmrGpuModel::getHourlyRate() const {
+    return hourlyRate;
+}
+
+double PmrGpuModel::getDailyStorageCost() const {
+    return dailyStorageCost;
+}
+
+int PmrGpuModel::getNumInstances() const {
+    return numInstances;
+}
+
+PmrGpuModel::allocator_type PmrGpuModel::get_allocator() const {
+    return name.get_allocator();
+}
+
+void PmrGpuModel::setName(std::string_view name) {
+    this->name.assign(name.data(), name.size());
+}
+
+void PmrGpuModel::setHourlyRate(double hourlyRate) {
+    this->hourlyRate = hourlyRate;
+}
+
+void PmrGpuModel::setDailyStorageCost(double dailyStorageCost) {
+    this->dailyStorageCost = dailyStorageCost;
+}
+
+void PmrGpuModel::setNumInstances(int numInstances) {
+    this->numInstances = numInstances;
+}
+
+FleetArena::FleetArena(std::size_t initialBytes, std::pmr::memory_resource* upstream)
+    : buffer(initialBytes, upstream) {
+}
+
+std::pmr::memory_resource* FleetArena::resource() {
+    return &buffer;
+}
+
+PmrFleet FleetArena::makeFleet(std::size_t expectedRows) {
+    PmrFleet fleet(&buffer);
+    fleet.reserve(expectedRows);
+    return fleet;
+}
+
+void FleetArena::release() {
+    buffer.release();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// GpuModel variant whose name lives in a std::pmr memory resource.
+// It is allocator-aware, so a std::pmr::vector<PmrGpuModel> hands its own resource
+// to every element and names are carved out of the same arena as the vector itself.
+class PmrGpuModel {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    PmrGpuModel(std::string_view name, double hourlyRate, double dailyStorageCost, int numInstances = 1,
+                const allocator_type& alloc = {});
+
+    explicit PmrGpuModel(const allocator_type& alloc = {});
+
+    PmrGpuModel(const PmrGpuModel& other) = default;
+    PmrGpuModel(PmrGpuModel&& other) = default;
+    PmrGpuModel(const PmrGpuModel& other, const allocator_type& alloc);
+    PmrGpuModel(PmrGpuModel&& other, const allocator_type& alloc);
+
+    PmrGpuModel& operator=(const PmrGpuModel& other) = default;
+    PmrGpuModel& operator=(PmrGpuModel&& other) = default;
+
+    const std::pmr::string& getName() const;
+    double getHourlyRate() const;
+    double getDailyStorageCost() const;
+    int getNumInstances() const;
+    allocator_type get_allocator() const;
+
+    void setName(std::string_view name);
+    void setHourlyRate(double hourlyRate);
+    void setDailyStorageCost(double dailyStorageCost);
+    void setNumInstances(int numInstances);
+
+private:
+    std::pmr::string name;
+    double hourlyRate;
+    double dailyStorageCost;
+    int numInstances;
+};
+
+using PmrFleet = std::pmr::vector<PmrGpuModel>;
+
+// Monotonic arena for batch loads.
+// Everything allocated for a fleet (the row array and every name) comes from a few large
+// blocks that are released together when the arena goes away, instead of one heap
+// allocation per row and per name.
+class FleetArena {
+public:
+    /**
+     * @param initialBytes Size of the first block requested from upstream
+     * @param upstream Resource the arena grows from
+     */
+    explicit FleetArena(std::size_t initialBytes = 1 << 20,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    FleetArena(const FleetArena&) = delete;
+    FleetArena& operator=(const FleetArena&) = delete;
+
+    std::pmr::memory_resource* resource();
+
+    // Empty fleet backed by the arena, with room for expectedRows rows
+    PmrFleet makeFleet(std::size_t expectedRows = 0);
+
+    // Release every block back to upstream; fleets made from this arena must not be used afterwards
+    void release();
+
+private:
+    std::pmr::monotonic_buffer_resource buffer;
+};
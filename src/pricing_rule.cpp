@@ -0,0 +1,382 @@
+#include "pricing_rule.h"
+#include "funds_calculator.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char* const VARIABLE_NAMES[] = {"rate", "instances", "hours", "days", "storage"};
+const std::uint32_t VARIABLE_COUNT = 5;
+
+// Rows interpreted per pass over the bytecode
+const std::size_t BLOCK_ROWS = 256;
+
+// Registers evaluate() keeps on the stack; rules needing more fall back to the heap
+const std::uint32_t SCALAR_REGISTERS = 64;
+
+void validateCostInputs(double hourlyRate, int numInstances, int runningHours, double dailyStorageCost) {
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (dailyStorageCost < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+    if (numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+    if (hourlyRate < 0) {
+        throw std::invalid_argument("Hourly rate can't be negative");
+    }
+}
+
+} // namespace
+
+// Builds the bytecode while parsing. Values are tagged as variable, constant or temporary
+// until the end, when constants are pooled and everything is renumbered into registers.
+class PricingRuleParser {
+public:
+    using Op = PricingRule::Op;
+
+    PricingRuleParser(const std::string& text, PricingRule& rule) : text(text), rule(rule) {}
+
+    void parse() {
+        Value result = parseComparison();
+        skipSpace();
+        if (pos != text.size()) {
+            fail("unexpected '" + std::string(1, text[pos]) + "'");
+        }
+        finish(result);
+    }
+
+private:
+    enum class Kind { Variable, Constant, Temporary };
+
+    struct Value {
+        Kind kind;
+        std::uint32_t index;
+        double constant;
+    };
+
+    struct PendingInstruction {
+        Op op;
+        std::uint32_t temp;
+        Value operands[3];
+    };
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("Pricing rule: " + message + " at position " + std::to_string(pos));
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace((unsigned char)(text[pos]))) {
+            pos++;
+        }
+    }
+
+    bool accept(const char* token) {
+        skipSpace();
+        std::size_t length = std::strlen(token);
+        if (text.compare(pos, length, token) == 0) {
+            pos += length;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const char* token) {
+        if (!accept(token)) {
+            fail(std::string("expected '") + token + "'");
+        }
+    }
+
+    Value emit(Op op, Value a, Value b = Value{Kind::Constant, 0, 0.0}, Value c = Value{Kind::Constant, 0, 0.0}) {
+        if (a.kind == Kind::Constant && b.kind == Kind::Constant && c.kind == Kind::Constant) {
+            return Value{Kind::Constant, 0, PricingRule::apply(op, a.constant, b.constant, c.constant)};
+        }
+        pending.push_back(PendingInstruction{op, tempCount, {a, b, c}});
+        return Value{Kind::Temporary, tempCount++, 0.0};
+    }
+
+    Value parseComparison() {
+        Value left = parseAdditive();
+        // Two-character operators first so "<=" isn't read as "<"
+        static const std::pair<const char*, Op> comparisons[] = {
+            {"<=", Op::LessEqual}, {">=", Op::GreaterEqual}, {"==", Op::Equal}, {"!=", Op::NotEqual},
+            {"<", Op::Less}, {">", Op::Greater},
+        };
+        for (const auto& comparison : comparisons) {
+            if (accept(comparison.first)) {
+                return emit(comparison.second, left, parseAdditive());
+            }
+        }
+        return left;
+    }
+
+    Value parseAdditive() {
+        Value value = parseTerm();
+        while (true) {
+            if (accept("+")) {
+                value = emit(Op::Add, value, parseTerm());
+            } else if (accept("-")) {
+                value = emit(Op::Sub, value, parseTerm());
+            } else {
+                return value;
+            }
+        }
+    }
+
+    Value parseTerm() {
+        Value value = parseUnary();
+        while (true) {
+            if (accept("*")) {
+                value = emit(Op::Mul, value, parseUnary());
+            } else if (accept("/")) {
+                value = emit(Op::Div, value, parseUnary());
+            } else {
+                return value;
+            }
+        }
+    }
+
+    Value parseUnary() {
+        if (accept("-")) {
+            return emit(Op::Neg, parseUnary());
+        }
+        return parsePrimary();
+    }
+
+    Value parsePrimary() {
+        skipSpace();
+        if (accept("(")) {
+            Value value = parseComparison();
+            expect(")");
+            return value;
+        }
+        if (pos < text.size() && (std::isdigit((unsigned char)(text[pos])) || text[pos] == '.')) {
+            double number = 0.0;
+            auto parsed = std::from_chars(text.data() + pos, text.data() + text.size(), number);
+            if (parsed.ec != std::errc()) {
+                fail("invalid number");
+            }
+            pos = (std::size_t)(parsed.ptr - text.data());
+            return Value{Kind::Constant, 0, number};
+        }
+
+        std::size_t start = pos;
+        while (pos < text.size() && (std::isalpha((unsigned char)(text[pos])) || text[pos] == '_')) {
+            pos++;
+        }
+        std::string name = text.substr(start, pos - start);
+        if (name.empty()) {
+            fail(pos < text.size() ? "unexpected '" + std::string(1, text[pos]) + "'" : "unexpected end of rule");
+        }
+        for (std::uint32_t v = 0; v < VARIABLE_COUNT; v++) {
+            if (name == VARIABLE_NAMES[v]) {
+                return Value{Kind::Variable, v, 0.0};
+            }
+        }
+        return parseCall(name, start);
+    }
+
+    Value parseCall(const std::string& name, std::size_t start) {
+        static const struct { const char* name; Op op; std::size_t arity; } functions[] = {
+            {"min", Op::Min, 2}, {"max", Op::Max, 2}, {"if", Op::Select, 3},
+            {"floor", Op::Floor, 1}, {"ceil", Op::Ceil, 1},
+        };
+        for (const auto& function : functions) {
+            if (name != function.name) {
+                continue;
+            }
+            expect("(");
+            std::vector<Value> args;
+            if (!accept(")")) {
+                do {
+                    args.push_back(parseComparison());
+                } while (accept(","));
+                expect(")");
+            }
+            if (args.size() != function.arity) {
+                pos = start;
+                fail(name + "() takes " + std::to_string(function.arity) + " arguments");
+            }
+            args.resize(3, Value{Kind::Constant, 0, 0.0});
+            return emit(function.op, args[0], args[1], args[2]);
+        }
+        pos = start;
+        fail("unknown name '" + name + "'");
+    }
+
+    std::uint32_t constantRegister(double value) {
+        for (std::size_t i = 0; i < rule.constants.size(); i++) {
+            if (std::memcmp(&rule.constants[i], &value, sizeof(value)) == 0) {
+                return VARIABLE_COUNT + (std::uint32_t)(i);
+            }
+        }
+        rule.constants.push_back(value);
+        return VARIABLE_COUNT + (std::uint32_t)(rule.constants.size() - 1);
+    }
+
+    std::uint32_t registerOf(const Value& value, std::uint32_t firstTemp) {
+        switch (value.kind) {
+        case Kind::Variable: return value.index;
+        case Kind::Constant: return constantRegister(value.constant);
+        case Kind::Temporary: return firstTemp + value.index;
+        }
+        return 0;
+    }
+
+    void finish(const Value& result) {
+        // Pool the constants first so temporaries can be numbered after them
+        for (const PendingInstruction& instruction : pending) {
+            for (const Value& operand : instruction.operands) {
+                if (operand.kind == Kind::Constant) {
+                    constantRegister(operand.constant);
+                }
+            }
+        }
+        if (result.kind == Kind::Constant) {
+            constantRegister(result.constant);
+        }
+
+        std::uint32_t firstTemp = VARIABLE_COUNT + (std::uint32_t)(rule.constants.size());
+        for (const PendingInstruction& instruction : pending) {
+            rule.code.push_back(PricingRule::Instruction{instruction.op, firstTemp + instruction.temp,
+                                                         registerOf(instruction.operands[0], firstTemp),
+                                                         registerOf(instruction.operands[1], firstTemp),
+                                                         registerOf(instruction.operands[2], firstTemp)});
+        }
+        rule.registerCount = firstTemp + tempCount;
+        rule.resultRegister = registerOf(result, firstTemp);
+    }
+
+    const std::string& text;
+    PricingRule& rule;
+    std::size_t pos = 0;
+    std::vector<PendingInstruction> pending;
+    std::uint32_t tempCount = 0;
+};
+
+PricingRule::PricingRule(const std::string& source) : source(source) {
+    PricingRuleParser(this->source, *this).parse();
+}
+
+double PricingRule::apply(Op op, double a, double b, double c) {
+    switch (op) {
+    case Op::Add: return a + b;
+    case Op::Sub: return a - b;
+    case Op::Mul: return a * b;
+    case Op::Div: return a / b;
+    case Op::Min: return std::min(a, b);
+    case Op::Max: return std::max(a, b);
+    case Op::Less: return a < b ? 1.0 : 0.0;
+    case Op::LessEqual: return a <= b ? 1.0 : 0.0;
+    case Op::Greater: return a > b ? 1.0 : 0.0;
+    case Op::GreaterEqual: return a >= b ? 1.0 : 0.0;
+    case Op::Equal: return a == b ? 1.0 : 0.0;
+    case Op::NotEqual: return a != b ? 1.0 : 0.0;
+    case Op::Select: return a != 0 ? b : c;
+    case Op::Neg: return -a;
+    case Op::Floor: return std::floor(a);
+    case Op::Ceil: return std::ceil(a);
+    }
+    return 0.0;
+}
+
+double PricingRule::evaluate(double hourlyRate, int numInstances, int runningHours, double dailyStorageCost) const {
+    // Input validation
+    validateCostInputs(hourlyRate, numInstances, runningHours, dailyStorageCost);
+
+    // One row: a register per value rather than evaluateBatch's block-wide register file
+    double stackRegisters[SCALAR_REGISTERS];
+    std::vector<double> heapRegisters;
+    double* registers = stackRegisters;
+    if (registerCount > SCALAR_REGISTERS) {
+        heapRegisters.resize(registerCount);
+        registers = heapRegisters.data();
+    }
+    registers[0] = hourlyRate;
+    registers[1] = (double)(numInstances);
+    registers[2] = (double)(runningHours);
+    registers[3] = (double)(calculateRunningDays(runningHours));
+    registers[4] = dailyStorageCost;
+    std::copy(constants.begin(), constants.end(), registers + VARIABLE_COUNT);
+
+    for (const Instruction& instruction : code) {
+        registers[instruction.dst] =
+            apply(instruction.op, registers[instruction.a], registers[instruction.b], registers[instruction.c]);
+    }
+    return std::round(registers[resultRegister] * 100.0) / 100.0;
+}
+
+void PricingRule::evaluateBatch(const double* hourlyRates, const int* instanceCounts, const int* runningHours,
+                                const double* dailyStorageCosts, std::size_t count, double* costs) const {
+    // Input validation
+    for (std::size_t i = 0; i < count; i++) {
+        validateCostInputs(hourlyRates[i], instanceCounts[i], runningHours[i], dailyStorageCosts[i]);
+    }
+
+    std::vector<double> registers((std::size_t)(registerCount) * BLOCK_ROWS);
+    auto row = [&](std::uint32_t reg) { return registers.data() + (std::size_t)(reg) * BLOCK_ROWS; };
+    for (std::size_t k = 0; k < constants.size(); k++) {
+        std::fill(row(VARIABLE_COUNT + (std::uint32_t)(k)), row(VARIABLE_COUNT + (std::uint32_t)(k)) + BLOCK_ROWS,
+                  constants[k]);
+    }
+
+    for (std::size_t start = 0; start < count; start += BLOCK_ROWS) {
+        std::size_t n = std::min(BLOCK_ROWS, count - start);
+        double* rate = row(0);
+        double* instances = row(1);
+        double* hours = row(2);
+        double* days = row(3);
+        double* storage = row(4);
+        for (std::size_t i = 0; i < n; i++) {
+            rate[i] = hourlyRates[start + i];
+            instances[i] = (double)(instanceCounts[start + i]);
+            hours[i] = (double)(runningHours[start + i]);
+            days[i] = (double)(calculateRunningDays(runningHours[start + i]));
+            storage[i] = dailyStorageCosts[start + i];
+        }
+
+        for (const Instruction& instruction : code) {
+            double* d = row(instruction.dst);
+            const double* a = row(instruction.a);
+            const double* b = row(instruction.b);
+            const double* c = row(instruction.c);
+            switch (instruction.op) {
+            case Op::Add: for (std::size_t i = 0; i < n; i++) d[i] = a[i] + b[i]; break;
+            case Op::Sub: for (std::size_t i = 0; i < n; i++) d[i] = a[i] - b[i]; break;
+            case Op::Mul: for (std::size_t i = 0; i < n; i++) d[i] = a[i] * b[i]; break;
+            case Op::Div: for (std::size_t i = 0; i < n; i++) d[i] = a[i] / b[i]; break;
+            case Op::Min: for (std::size_t i = 0; i < n; i++) d[i] = std::min(a[i], b[i]); break;
+            case Op::Max: for (std::size_t i = 0; i < n; i++) d[i] = std::max(a[i], b[i]); break;
+            case Op::Less: for (std::size_t i = 0; i < n; i++) d[i] = a[i] < b[i] ? 1.0 : 0.0; break;
+            case Op::LessEqual: for (std::size_t i = 0; i < n; i++) d[i] = a[i] <= b[i] ? 1.0 : 0.0; break;
+            case Op::Greater: for (std::size_t i = 0; i < n; i++) d[i] = a[i] > b[i] ? 1.0 : 0.0; break;
+            case Op::GreaterEqual: for (std::size_t i = 0; i < n; i++) d[i] = a[i] >= b[i] ? 1.0 : 0.0; break;
+            case Op::Equal: for (std::size_t i = 0; i < n; i++) d[i] = a[i] == b[i] ? 1.0 : 0.0; break;
+            case Op::NotEqual: for (std::size_t i = 0; i < n; i++) d[i] = a[i] != b[i] ? 1.0 : 0.0; break;
+            case Op::Select: for (std::size_t i = 0; i < n; i++) d[i] = a[i] != 0 ? b[i] : c[i]; break;
+            case Op::Neg: for (std::size_t i = 0; i < n; i++) d[i] = -a[i]; break;
+            case Op::Floor: for (std::size_t i = 0; i < n; i++) d[i] = std::floor(a[i]); break;
+            case Op::Ceil: for (std::size_t i = 0; i < n; i++) d[i] = std::ceil(a[i]); break;
+            }
+        }
+
+        const double* result = row(resultRegister);
+        for (std::size_t i = 0; i < n; i++) {
+            costs[start + i] = std::round(result[i] * 100.0) / 100.0;
+        }
+    }
+}
+
+const std::string& PricingRule::getSource() const {
+    return source;
+}
+
+std::size_t PricingRule::getInstructionCount() const {
+    return code.size();
+}
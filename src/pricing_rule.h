@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A billing formula written as an expression over the variables
+//     rate, instances, hours, days, storage
+// (days is calculateRunningDays(hours)), e.g. the built-in formula is
+//     rate * instances * hours + storage * instances * days
+// Operators: + - * / unary -, comparisons < <= > >= == != (1 or 0), parentheses.
+// Functions: min(a, b), max(a, b), if(cond, a, b), floor(x), ceil(x).
+//
+// The source is parsed once into register bytecode, with constant subexpressions folded.
+// Batches are interpreted a block of rows at a time: each instruction runs as a tight loop
+// over the block, so dispatch is paid once per block rather than once per row. A single
+// evaluate() runs the same bytecode over a small register array on the stack.
+// Results are rounded to cents, as calculateTotalCost does.
+class PricingRule {
+public:
+    /**
+     * Compile a rule. Throws std::invalid_argument naming the position of a syntax error.
+     *
+     * @param source The rule text
+     */
+    explicit PricingRule(const std::string& source);
+
+    double evaluate(double hourlyRate, int numInstances, int runningHours, double dailyStorageCost) const;
+
+    // costs[i] = evaluate(hourlyRates[i], instanceCounts[i], runningHours[i], dailyStorageCosts[i]).
+    // Inputs are validated first with calculateTotalCost's rules and messages.
+    void evaluateBatch(const double* hourlyRates, const int* instanceCounts, const int* runningHours,
+                       const double* dailyStorageCosts, std::size_t count, double* costs) const;
+
+    const std::string& getSource() const;
+    std::size_t getInstructionCount() const;
+
+private:
+    enum class Op : std::uint8_t {
+        Add, Sub, Mul, Div, Min, Max, Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual,
+        Select, Neg, Floor, Ceil
+    };
+
+    struct Instruction {
+        Op op;
+        std::uint32_t dst;
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t c;
+    };
+
+    friend class PricingRuleParser;
+
+    static double apply(Op op, double a, double b, double c);
+
+    std::string source;
+    std::vector<Instruction> code;
+    // Registers 0-4 hold the variables, then one register per constant, then temporaries
+    std::vector<double> constants;
+    std::uint32_t registerCount = 0;
+    std::uint32_t resultRegister = 0;
+};
@@ -0,0 +1,283 @@
+#include "process_sweep.h"
+#include "funds_calculator.h"
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <signal.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// A shard's state word packs the owning worker's pid above the state, so claiming a shard and
+// recording its owner is one compare-and-swap and a crash can never leave an ownerless claim
+enum ShardState : std::uint64_t { SHARD_PENDING = 0, SHARD_CLAIMED = 1, SHARD_DONE = 2, SHARD_FAILED = 3 };
+
+struct SweepShard {
+    std::atomic<std::uint64_t> word;
+    std::atomic<std::uint32_t> attempts;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shard table needs address-free atomics");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shard table needs address-free atomics");
+
+std::uint64_t packShard(pid_t pid, ShardState state) {
+    return ((std::uint64_t)(pid) << 8) | state;
+}
+
+ShardState stateOf(std::uint64_t word) {
+    return (ShardState)(word & 0xff);
+}
+
+pid_t ownerOf(std::uint64_t word) {
+    return (pid_t)(word >> 8);
+}
+
+// Shared mapping holding the shard table followed by the results
+class SharedSweepRegion {
+public:
+    SharedSweepRegion(std::size_t shardCount, std::size_t resultCount) {
+        static std::atomic<unsigned> sequence(0);
+        std::string name = "/vastgpu-sweep-" + std::to_string(getpid()) + "-" + std::to_string(sequence++);
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("Sweep shared memory: " + std::string(std::strerror(errno)));
+        }
+        // Only inherited mappings are needed, so the name can go straight away
+        shm_unlink(name.c_str());
+
+        resultsOffset = (shardCount * sizeof(SweepShard) + 63) & ~(std::size_t)(63);
+        length = resultsOffset + resultCount * sizeof(SweepResult);
+        if (length == 0) {
+            length = 1;
+        }
+        if (ftruncate(fd, (off_t)(length)) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Sweep shared memory: " + std::string(std::strerror(error)));
+        }
+        void* mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("Sweep shared memory: " + std::string(std::strerror(errno)));
+        }
+        base = static_cast<unsigned char*>(mapped);
+
+        for (std::size_t s = 0; s < shardCount; s++) {
+            new (&shards()[s]) SweepShard();
+            shards()[s].word.store(packShard(0, SHARD_PENDING));
+            shards()[s].attempts.store(0);
+        }
+    }
+
+    ~SharedSweepRegion() {
+        munmap(base, length);
+    }
+
+    SharedSweepRegion(const SharedSweepRegion&) = delete;
+    SharedSweepRegion& operator=(const SharedSweepRegion&) = delete;
+
+    SweepShard* shards() {
+        return reinterpret_cast<SweepShard*>(base);
+    }
+
+    SweepResult* results() {
+        return reinterpret_cast<SweepResult*>(base + resultsOffset);
+    }
+
+private:
+    unsigned char* base = nullptr;
+    std::size_t length = 0;
+    std::size_t resultsOffset = 0;
+};
+
+void validateScenario(const SweepScenario& scenario) {
+    if (scenario.initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (scenario.runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (scenario.dailyStorageCost < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+    if (scenario.numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+    if (scenario.hourlyRate < 0) {
+        throw std::invalid_argument("Hourly rate can't be negative");
+    }
+}
+
+// Claim the first pending shard, scanning from the start because shards handed back after a
+// crash can sit before ones already taken. Returns shardCount when nothing is left.
+std::size_t claimShard(SweepShard* shards, std::size_t shardCount, pid_t self) {
+    for (std::size_t s = 0; s < shardCount; s++) {
+        std::uint64_t expected = packShard(0, SHARD_PENDING);
+        if (shards[s].word.compare_exchange_strong(expected, packShard(self, SHARD_CLAIMED))) {
+            return s;
+        }
+    }
+    return shardCount;
+}
+
+// Worker body; never returns
+[[noreturn]] void runWorker(const std::vector<SweepScenario>& scenarios, const ProcessSweepConfig& config,
+                            SharedSweepRegion& region, std::size_t shardCount) {
+    pid_t self = getpid();
+    SweepShard* shards = region.shards();
+    SweepResult* results = region.results();
+
+    try {
+        for (std::size_t s = claimShard(shards, shardCount, self); s < shardCount;
+             s = claimShard(shards, shardCount, self)) {
+            if (config.beforeShard) {
+                config.beforeShard(s, shards[s].attempts.load());
+            }
+
+            std::size_t begin = s * config.shardSize;
+            std::size_t end = std::min(scenarios.size(), begin + config.shardSize);
+            for (std::size_t i = begin; i < end; i++) {
+                const SweepScenario& scenario = scenarios[i];
+                double totalCost = calculateTotalCost(scenario.hourlyRate, scenario.numInstances,
+                                                      scenario.runningHours, scenario.dailyStorageCost);
+                results[i] = SweepResult{totalCost, calculateRemainingFunds(scenario.initialFunds, totalCost),
+                                         calculateFundsDuration(scenario.initialFunds, scenario.hourlyRate,
+                                                                scenario.numInstances, scenario.dailyStorageCost)};
+            }
+            shards[s].word.store(packShard(self, SHARD_DONE), std::memory_order_release);
+        }
+    } catch (...) {
+        _exit(1);  // never unwind into the coordinator's stack in the child
+    }
+    _exit(0);
+}
+
+} // namespace
+
+std::vector<SweepResult> runProcessSweep(const std::vector<SweepScenario>& scenarios,
+                                         const ProcessSweepConfig& config, ProcessSweepStats* stats) {
+    // Input validation
+    if (config.shardSize == 0) {
+        throw std::invalid_argument("Shard size must be positive");
+    }
+    if (config.maxAttempts == 0) {
+        throw std::invalid_argument("Shard attempts must be positive");
+    }
+    for (const SweepScenario& scenario : scenarios) {
+        validateScenario(scenario);
+    }
+
+    ProcessSweepStats localStats;
+    ProcessSweepStats& counters = stats != nullptr ? *stats : localStats;
+    counters = ProcessSweepStats();
+
+    std::size_t shardCount = (scenarios.size() + config.shardSize - 1) / config.shardSize;
+    if (shardCount == 0) {
+        return std::vector<SweepResult>();
+    }
+    SharedSweepRegion region(shardCount, scenarios.size());
+    SweepShard* shards = region.shards();
+
+    unsigned workerCount = config.workerCount == 0 ? defaultThreadCount() : config.workerCount;
+    workerCount = (unsigned)(std::min<std::size_t>(workerCount, shardCount));
+
+    std::vector<pid_t> workers;
+    auto spawn = [&]() {
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw std::runtime_error("Sweep worker: " + std::string(std::strerror(errno)));
+        }
+        if (pid == 0) {
+            runWorker(scenarios, config, region, shardCount);
+        }
+        workers.push_back(pid);
+        counters.workersStarted++;
+    };
+    auto stopWorkers = [&]() {
+        for (pid_t pid : workers) {
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+        }
+        workers.clear();
+    };
+
+    std::string failure;
+    try {
+        for (unsigned w = 0; w < workerCount; w++) {
+            spawn();
+        }
+
+        while (!workers.empty()) {
+            bool reaped = false;
+            for (std::size_t w = 0; w < workers.size(); w++) {
+                int status = 0;
+                pid_t pid = waitpid(workers[w], &status, WNOHANG);
+                if (pid == 0) {
+                    continue;
+                }
+                reaped = true;
+                workers.erase(workers.begin() + (std::ptrdiff_t)(w));
+                w--;
+                if (pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                    continue;
+                }
+
+                // Hand the dead worker's shards back, or give up on them after maxAttempts
+                counters.workerFailures++;
+                bool handedBack = false;
+                for (std::size_t s = 0; s < shardCount; s++) {
+                    std::uint64_t word = shards[s].word.load();
+                    if (stateOf(word) != SHARD_CLAIMED || ownerOf(word) != pid) {
+                        continue;
+                    }
+                    unsigned attempts = shards[s].attempts.fetch_add(1) + 1;
+                    if (attempts >= config.maxAttempts) {
+                        shards[s].word.store(packShard(0, SHARD_FAILED));
+                        failure = "Sweep shard " + std::to_string(s) + " failed after "
+                                  + std::to_string(attempts) + " attempts";
+                    } else {
+                        shards[s].word.store(packShard(0, SHARD_PENDING));
+                        counters.shardsRetried++;
+                        handedBack = true;
+                    }
+                }
+                if (!failure.empty()) {
+                    break;
+                }
+                if (handedBack) {
+                    spawn();
+                }
+            }
+            if (!failure.empty()) {
+                break;
+            }
+            if (!reaped) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    } catch (...) {
+        stopWorkers();
+        throw;
+    }
+    stopWorkers();
+    if (!failure.empty()) {
+        throw std::runtime_error(failure);
+    }
+
+    for (std::size_t s = 0; s < shardCount; s++) {
+        if (stateOf(shards[s].word.load(std::memory_order_acquire)) != SHARD_DONE) {
+            throw std::runtime_error("Sweep shard " + std::to_string(s) + " was not completed");
+        }
+    }
+    return std::vector<SweepResult>(region.results(), region.results() + scenarios.size());
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// One configuration in a scenario sweep
+struct SweepScenario {
+    double initialFunds;
+    double hourlyRate;
+    double dailyStorageCost;
+    int numInstances;
+    int runningHours;
+};
+
+// calculateTotalCost, calculateRemainingFunds and calculateFundsDuration for one scenario
+struct SweepResult {
+    double totalCost;
+    double remainingFunds;
+    double fundsDuration;
+};
+
+struct ProcessSweepConfig {
+    unsigned workerCount = 0;        // worker processes; 0 = hardware concurrency
+    std::size_t shardSize = 65536;   // scenarios per shard
+    unsigned maxAttempts = 3;        // tries per shard before the sweep fails
+    // Runs in the worker after it claims a shard (attempt counts from 0); for fault-injection tests
+    std::function<void(std::size_t shard, unsigned attempt)> beforeShard;
+};
+
+struct ProcessSweepStats {
+    unsigned workersStarted = 0;
+    unsigned workerFailures = 0;
+    std::size_t shardsRetried = 0;
+};
+
+// Price a sweep in forked worker processes.
+// The coordinator places a shard table and the result array in a POSIX shared-memory region;
+// workers inherit the scenarios copy-on-write, claim shards with compare-and-swap on the shard
+// table and write results straight into the shared region. If a worker dies, the coordinator
+// returns the shards it had claimed to the queue and starts a replacement. Workers inherit the
+// coordinator's CPU affinity, so `taskset` or numactl on the coordinator pins the whole sweep.
+//
+// Scenarios are validated up front with the scalar calculators' messages. Throws
+// std::runtime_error if shared memory or fork fails or a shard fails maxAttempts times.
+std::vector<SweepResult> runProcessSweep(const std::vector<SweepScenario>& scenarios,
+                                         const ProcessSweepConfig& config = ProcessSweepConfig(),
+                                         ProcessSweepStats* stats = nullptr);
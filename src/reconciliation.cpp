@@ -0,0 +1,425 @@
+#include "reconciliation.h"
+#include "fleet_csv.h"
+#include "funds_calculator.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Keys pack (model, instance, day) into 64 bits; rows that don't fit can't have been predicted
+const int KEY_INSTANCE_BITS = 24;
+const int KEY_DAY_BITS = 20;
+const std::uint64_t KEY_MODEL_LIMIT = 1ull << (64 - KEY_INSTANCE_BITS - KEY_DAY_BITS);
+const std::uint64_t KEY_INSTANCE_LIMIT = 1ull << KEY_INSTANCE_BITS;
+const std::uint64_t KEY_DAY_LIMIT = 1ull << KEY_DAY_BITS;
+
+const int PARTITION_BITS = 6;
+const std::size_t PARTITION_COUNT = 1u << PARTITION_BITS;
+const std::size_t PARTITION_CHUNK_ROWS = 1u << 16;
+
+const std::uint64_t EMPTY_SLOT = UINT64_MAX;
+
+std::uint64_t packKey(std::uint64_t modelId, std::uint64_t instance, std::uint64_t day) {
+    return (modelId << (KEY_INSTANCE_BITS + KEY_DAY_BITS)) | (instance << KEY_DAY_BITS) | day;
+}
+
+BillingDiscrepancy unpackKey(std::uint64_t key, double billed, double predicted) {
+    return BillingDiscrepancy{(std::uint32_t)(key >> (KEY_INSTANCE_BITS + KEY_DAY_BITS)),
+                              (std::uint32_t)((key >> KEY_DAY_BITS) & (KEY_INSTANCE_LIMIT - 1)),
+                              (std::uint32_t)(key & (KEY_DAY_LIMIT - 1)), billed, predicted};
+}
+
+// splitmix64 finalizer; the top bits pick the partition, the low bits the table slot
+std::uint64_t mixKey(std::uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    return key ^ (key >> 31);
+}
+
+std::size_t partitionOf(std::uint64_t key) {
+    return (std::size_t)(mixKey(key) >> (64 - PARTITION_BITS));
+}
+
+// (key, amount) pairs grouped by partition; partition p is [start[p], start[p + 1])
+struct PartitionedAmounts {
+    std::vector<std::uint64_t> keys;
+    std::vector<double> amounts;
+    std::vector<std::size_t> start;
+};
+
+// Two-pass radix partition: per-chunk histograms, then a scatter with each chunk writing at
+// its own offsets. Offsets are laid out partition-major, chunk-minor, so within a partition
+// rows keep input order and per-partition sums don't depend on the thread count.
+// rowAt(i, key, amount) returns false for rows that have no key.
+template <typename RowAt>
+PartitionedAmounts partitionByKey(std::size_t count, unsigned threadCount, RowAt rowAt) {
+    std::size_t chunkCount = (count + PARTITION_CHUNK_ROWS - 1) / PARTITION_CHUNK_ROWS;
+    std::vector<std::size_t> offsets(chunkCount * PARTITION_COUNT, 0);
+
+    parallelForChunks(count, PARTITION_CHUNK_ROWS, threadCount,
+                      [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+                          std::size_t* histogram = &offsets[chunk * PARTITION_COUNT];
+                          std::uint64_t key;
+                          double amount;
+                          for (std::size_t i = begin; i < end; i++) {
+                              if (rowAt(i, key, amount)) {
+                                  histogram[partitionOf(key)]++;
+                              }
+                          }
+                      });
+
+    PartitionedAmounts result;
+    result.start.assign(PARTITION_COUNT + 1, 0);
+    std::size_t total = 0;
+    for (std::size_t p = 0; p < PARTITION_COUNT; p++) {
+        result.start[p] = total;
+        for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+            std::size_t rows = offsets[chunk * PARTITION_COUNT + p];
+            offsets[chunk * PARTITION_COUNT + p] = total;
+            total += rows;
+        }
+    }
+    result.start[PARTITION_COUNT] = total;
+    result.keys.resize(total);
+    result.amounts.resize(total);
+
+    parallelForChunks(count, PARTITION_CHUNK_ROWS, threadCount,
+                      [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+                          std::size_t* next = &offsets[chunk * PARTITION_COUNT];
+                          std::uint64_t key;
+                          double amount;
+                          for (std::size_t i = begin; i < end; i++) {
+                              if (rowAt(i, key, amount)) {
+                                  std::size_t slot = next[partitionOf(key)]++;
+                                  result.keys[slot] = key;
+                                  result.amounts[slot] = amount;
+                              }
+                          }
+                      });
+    return result;
+}
+
+// What one partition found; merged into the report in partition order
+struct PartitionResult {
+    std::vector<ModelReconciliation> models;
+    std::vector<BillingDiscrepancy> flagged;
+    std::size_t matchedKeys = 0;
+    std::size_t unbilledKeys = 0;
+    std::size_t unexpectedKeys = 0;
+};
+
+void recordKey(PartitionResult& result, std::uint64_t key, double billed, double predicted, double tolerance) {
+    BillingDiscrepancy entry = unpackKey(key, billed, predicted);
+    ModelReconciliation& model = result.models[entry.modelId];
+    model.billed += billed;
+    model.predicted += predicted;
+    double difference = billed - predicted;
+    if (std::fabs(difference) > tolerance) {
+        if (difference > 0) {
+            model.overbilled += difference;
+        } else {
+            model.underbilled -= difference;
+        }
+        model.flaggedKeys++;
+        result.flagged.push_back(entry);
+    }
+}
+
+void joinPartition(const PartitionedAmounts& billed, const PartitionedAmounts& predicted, std::size_t p,
+                   double tolerance, PartitionResult& result) {
+    std::size_t billedBegin = billed.start[p];
+    std::size_t billedEnd = billed.start[p + 1];
+
+    // Build: sum the billed amounts per key in an open-addressing table at most half full
+    std::size_t capacity = 16;
+    while (capacity < 2 * (billedEnd - billedBegin)) {
+        capacity *= 2;
+    }
+    std::size_t mask = capacity - 1;
+    std::vector<std::uint64_t> slotKeys(capacity, EMPTY_SLOT);
+    std::vector<double> slotSums(capacity, 0.0);
+    std::vector<char> slotMatched(capacity, 0);
+
+    for (std::size_t i = billedBegin; i < billedEnd; i++) {
+        std::uint64_t key = billed.keys[i];
+        std::size_t slot = (std::size_t)(mixKey(key)) & mask;
+        while (slotKeys[slot] != EMPTY_SLOT && slotKeys[slot] != key) {
+            slot = (slot + 1) & mask;
+        }
+        slotKeys[slot] = key;
+        slotSums[slot] += billed.amounts[i];
+    }
+
+    // Probe with the predictions, which are unique per key
+    for (std::size_t i = predicted.start[p]; i < predicted.start[p + 1]; i++) {
+        std::uint64_t key = predicted.keys[i];
+        std::size_t slot = (std::size_t)(mixKey(key)) & mask;
+        while (slotKeys[slot] != EMPTY_SLOT && slotKeys[slot] != key) {
+            slot = (slot + 1) & mask;
+        }
+        if (slotKeys[slot] == key) {
+            slotMatched[slot] = 1;
+            result.matchedKeys++;
+            recordKey(result, key, slotSums[slot], predicted.amounts[i], tolerance);
+        } else {
+            result.unbilledKeys++;
+            recordKey(result, key, 0.0, predicted.amounts[i], tolerance);
+        }
+    }
+
+    // Whatever was billed and never probed wasn't predicted
+    for (std::size_t slot = 0; slot < capacity; slot++) {
+        if (slotKeys[slot] != EMPTY_SLOT && !slotMatched[slot]) {
+            result.unexpectedKeys++;
+            recordKey(result, slotKeys[slot], slotSums[slot], 0.0, tolerance);
+        }
+    }
+}
+
+} // namespace
+
+StringInterner makeFleetInterner(const std::vector<GpuModel>& gpuModels) {
+    StringInterner models;
+    for (const auto& gpu : gpuModels) {
+        models.intern(gpu.getName());
+    }
+    return models;
+}
+
+bool parseBillingCharge(std::string_view line, const StringInterner& models, BillingCharge& charge,
+                        std::string& error) {
+    std::string_view fields[4];
+    if (!detail::splitCsvRow(line, fields, error)) {
+        return false;
+    }
+    if (fields[0].empty()) {
+        error = "GPU model name can't be empty";
+        return false;
+    }
+    if (!detail::parseCsvNumber(fields[1], charge.instance)) {
+        error = "Invalid instance number";
+        return false;
+    }
+    if (!detail::parseCsvNumber(fields[2], charge.hour)) {
+        error = "Invalid hour";
+        return false;
+    }
+    if (!detail::parseCsvNumber(fields[3], charge.amount) || !std::isfinite(charge.amount)) {
+        error = "Invalid charge amount";
+        return false;
+    }
+
+    charge.modelId = models.find(fields[0]);
+    return true;
+}
+
+BillingExport readBillingExport(const std::string& path, const StringInterner& models,
+                                const CsvIngestConfig& config) {
+    MappedFile file(path, "Billing export");
+    return readBillingExportBuffer(file.data, file.length, models, config);
+}
+
+BillingExport readBillingExportBuffer(const char* data, std::size_t length, const StringInterner& models,
+                                      const CsvIngestConfig& config) {
+    // Input validation
+    if (config.chunkBytes == 0) {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+
+    BillingExport result;
+    if (length == 0) {
+        return result;
+    }
+    const char* fileEnd = data + length;
+    std::size_t chunkCount = (length + config.chunkBytes - 1) / config.chunkBytes;
+    std::vector<BillingExport> pieces(chunkCount);
+
+    // Each piece counts lines from its own start; the merge shifts them
+    parallelForLineChunks(data, length, config.chunkBytes, config.threadCount,
+                          [&](const char* begin, const char* end, std::size_t chunk) {
+                              BillingExport& piece = pieces[chunk];
+                              BillingCharge charge;
+                              std::string error;
+                              for (const char* p = begin; p < end;) {
+                                  const char* newline =
+                                      static_cast<const char*>(std::memchr(p, '\n', (std::size_t)(fileEnd - p)));
+                                  const char* lineEnd = newline ? newline : fileEnd;
+                                  std::string_view line(p, (std::size_t)(lineEnd - p));
+                                  bool firstLine = p == data;
+                                  p = newline ? newline + 1 : fileEnd;
+                                  piece.lineCount++;
+
+                                  if (line.empty() || line[0] == '#' || line == "\r" ||
+                                      (firstLine && line.rfind("model,", 0) == 0)) {
+                                      continue;
+                                  }
+                                  if (parseBillingCharge(line, models, charge, error)) {
+                                      piece.charges.push_back(charge);
+                                      continue;
+                                  }
+                                  if (piece.errors.size() < config.maxErrors) {
+                                      piece.errors.push_back(CsvRowError{piece.lineCount, error});
+                                  }
+                                  piece.errorRows++;
+                              }
+                          });
+
+    std::size_t chargeCount = 0;
+    for (const BillingExport& piece : pieces) {
+        chargeCount += piece.charges.size();
+    }
+    result.charges.reserve(chargeCount);
+    for (BillingExport& piece : pieces) {
+        result.charges.insert(result.charges.end(), piece.charges.begin(), piece.charges.end());
+        for (auto& error : piece.errors) {
+            if (result.errors.size() < config.maxErrors) {
+                result.errors.push_back(CsvRowError{result.lineCount + error.lineNumber, std::move(error.message)});
+            }
+        }
+        result.errorRows += piece.errorRows;
+        result.lineCount += piece.lineCount;
+    }
+    return result;
+}
+
+ReconciliationReport reconcileBilling(const std::vector<GpuModel>& gpuModels, int runningHours,
+                                      const std::vector<BillingCharge>& charges, double tolerance,
+                                      unsigned threadCount) {
+    // Input validation
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (tolerance < 0) {
+        throw std::invalid_argument("Tolerance can't be negative");
+    }
+    for (const auto& gpu : gpuModels) {
+        detail::validateFleetRow(gpu);
+    }
+
+    StringInterner models = makeFleetInterner(gpuModels);
+    std::size_t modelCount = models.size();
+    std::uint64_t days = ((std::uint64_t)(runningHours) + 23) / 24;
+    if (modelCount > KEY_MODEL_LIMIT || days > KEY_DAY_LIMIT) {
+        throw std::invalid_argument("Fleet is too large to reconcile");
+    }
+
+    // Predicted charge per instance-day, instances numbered per model name in fleet order
+    std::vector<std::uint64_t> predictedKeys;
+    std::vector<double> predictedAmounts;
+    std::vector<std::uint64_t> nextInstance(modelCount, 0);
+    for (const auto& gpu : gpuModels) {
+        std::uint32_t modelId = models.find(gpu.getName());
+        std::uint64_t firstInstance = nextInstance[modelId];
+        nextInstance[modelId] += (std::uint64_t)(gpu.getNumInstances());
+        if (nextInstance[modelId] > KEY_INSTANCE_LIMIT) {
+            throw std::invalid_argument("Fleet is too large to reconcile");
+        }
+        double fullDay = calculateTotalCost(gpu.getHourlyRate(), 1, 24, gpu.getDailyStorageCost());
+        for (std::uint64_t instance = firstInstance; instance < nextInstance[modelId]; instance++) {
+            for (std::uint64_t day = 0; day < days; day++) {
+                int hoursThatDay = std::min(24, runningHours - (int)(day) * 24);
+                predictedKeys.push_back(packKey(modelId, instance, day));
+                predictedAmounts.push_back(hoursThatDay == 24 ? fullDay
+                                                              : calculateTotalCost(gpu.getHourlyRate(), 1, hoursThatDay,
+                                                                                   gpu.getDailyStorageCost()));
+            }
+        }
+    }
+
+    // Charges against unknown models, or outside the key range, can't match anything and are
+    // reported one row at a time
+    auto isKeyed = [&](const BillingCharge& charge) {
+        return charge.modelId < modelCount && charge.instance < KEY_INSTANCE_LIMIT && charge.hour / 24 < KEY_DAY_LIMIT;
+    };
+
+    PartitionedAmounts billed = partitionByKey(charges.size(), threadCount,
+                                               [&](std::size_t i, std::uint64_t& key, double& amount) {
+                                                   const BillingCharge& charge = charges[i];
+                                                   if (!isKeyed(charge)) {
+                                                       return false;
+                                                   }
+                                                   key = packKey(charge.modelId, charge.instance, charge.hour / 24);
+                                                   amount = charge.amount;
+                                                   return true;
+                                               });
+    PartitionedAmounts predicted = partitionByKey(predictedKeys.size(), threadCount,
+                                                  [&](std::size_t i, std::uint64_t& key, double& amount) {
+                                                      key = predictedKeys[i];
+                                                      amount = predictedAmounts[i];
+                                                      return true;
+                                                  });
+
+    std::vector<PartitionResult> partitions(PARTITION_COUNT);
+    parallelForChunks(PARTITION_COUNT, 1, threadCount, [&](std::size_t p, std::size_t, std::size_t) {
+        partitions[p].models.resize(modelCount);
+        joinPartition(billed, predicted, p, tolerance, partitions[p]);
+    });
+
+    ReconciliationReport report;
+    report.models.resize(modelCount);
+    for (std::size_t id = 0; id < modelCount; id++) {
+        report.models[id].name = models.nameOf((std::uint32_t)(id));
+    }
+    for (const auto& partition : partitions) {
+        for (std::size_t id = 0; id < modelCount; id++) {
+            ModelReconciliation& model = report.models[id];
+            model.billed += partition.models[id].billed;
+            model.predicted += partition.models[id].predicted;
+            model.overbilled += partition.models[id].overbilled;
+            model.underbilled += partition.models[id].underbilled;
+            model.flaggedKeys += partition.models[id].flaggedKeys;
+        }
+        report.flagged.insert(report.flagged.end(), partition.flagged.begin(), partition.flagged.end());
+        report.matchedKeys += partition.matchedKeys;
+        report.unbilledKeys += partition.unbilledKeys;
+        report.unexpectedKeys += partition.unexpectedKeys;
+    }
+
+    // Unkeyed charges, sequentially in input order
+    ModelReconciliation unknown;
+    unknown.name = "(unknown)";
+    bool anyUnknown = false;
+    for (const auto& charge : charges) {
+        if (isKeyed(charge)) {
+            continue;
+        }
+        anyUnknown = anyUnknown || charge.modelId >= modelCount;
+        ModelReconciliation& model = charge.modelId < modelCount ? report.models[charge.modelId] : unknown;
+        model.billed += charge.amount;
+        report.unexpectedKeys++;
+        if (std::fabs(charge.amount) > tolerance) {
+            if (charge.amount > 0) {
+                model.overbilled += charge.amount;
+            } else {
+                model.underbilled -= charge.amount;
+            }
+            model.flaggedKeys++;
+            report.flagged.push_back(BillingDiscrepancy{charge.modelId, charge.instance, charge.hour / 24,
+                                                        charge.amount, 0.0});
+        }
+    }
+    if (anyUnknown) {
+        report.models.push_back(unknown);
+    }
+
+    std::stable_sort(report.flagged.begin(), report.flagged.end(),
+                     [](const BillingDiscrepancy& a, const BillingDiscrepancy& b) {
+                         if (a.modelId != b.modelId) {
+                             return a.modelId < b.modelId;
+                         }
+                         if (a.instance != b.instance) {
+                             return a.instance < b.instance;
+                         }
+                         return a.day < b.day;
+                     });
+    for (const auto& model : report.models) {
+        report.totalBilled += model.billed;
+        report.totalPredicted += model.predicted;
+    }
+    return report;
+}
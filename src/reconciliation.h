@@ -0,0 +1,89 @@
+#pragma once
+
+#include "csv_ingest.h"
+#include "gpu_model.h"
+#include "string_interner.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One line of a marketplace billing export: a charge for one instance of a model for one hour.
+// modelId is the model name's id in the fleet interner (see makeFleetInterner), or
+// StringInterner::NOT_FOUND for a model the fleet doesn't have.
+struct BillingCharge {
+    std::uint32_t modelId;
+    std::uint32_t instance;
+    std::uint32_t hour;
+    double amount;
+};
+
+// Interner holding the fleet's model names, for mapping billing rows to model ids
+StringInterner makeFleetInterner(const std::vector<GpuModel>& gpuModels);
+
+// Parse one export line of the form
+//     model,instance,hour,amount
+// On failure returns false and sets error.
+bool parseBillingCharge(std::string_view line, const StringInterner& models, BillingCharge& charge,
+                        std::string& error);
+
+struct BillingExport {
+    std::vector<BillingCharge> charges;  // in file order
+    std::vector<CsvRowError> errors;     // the first maxErrors, in line order
+    std::size_t errorRows = 0;
+    std::size_t lineCount = 0;
+};
+
+// Read a billing export of parseBillingCharge lines, skipping blank lines, '#' comments and a
+// leading "model,..." header. The file is mapped and cut into line-aligned pieces parsed in
+// parallel, as ingestFleetCsv does; pieces are merged in file order.
+// Throws std::runtime_error if the file can't be read.
+BillingExport readBillingExport(const std::string& path, const StringInterner& models,
+                                const CsvIngestConfig& config = CsvIngestConfig());
+
+// The same over text already in memory
+BillingExport readBillingExportBuffer(const char* data, std::size_t length, const StringInterner& models,
+                                      const CsvIngestConfig& config = CsvIngestConfig());
+
+// An (model, instance, day) whose billed and predicted amounts differ by more than the tolerance
+struct BillingDiscrepancy {
+    std::uint32_t modelId;
+    std::uint32_t instance;
+    std::uint32_t day;
+    double billed;
+    double predicted;
+};
+
+struct ModelReconciliation {
+    std::string name;       // "(unknown)" for charges against models not in the fleet
+    double billed = 0.0;
+    double predicted = 0.0;
+    double overbilled = 0.0;  // sum of billed - predicted over flagged keys billed too much
+    double underbilled = 0.0; // sum of predicted - billed over flagged keys billed too little
+    std::size_t flaggedKeys = 0;
+};
+
+struct ReconciliationReport {
+    std::vector<ModelReconciliation> models;  // fleet model ids in order, then unknown models
+    std::vector<BillingDiscrepancy> flagged;  // sorted by model, instance, day
+    std::size_t matchedKeys = 0;
+    std::size_t unbilledKeys = 0;             // predicted but absent from the export
+    std::size_t unexpectedKeys = 0;           // billed but not predicted
+    double totalBilled = 0.0;
+    double totalPredicted = 0.0;
+};
+
+// Join a billing export against the fleet's predicted charges for runningHours hours.
+// Instances of a model name are numbered from 0 across the fleet's rows with that name, in
+// fleet order. Each instance-day is predicted as calculateTotalCost(rate, 1, hoursThatDay,
+// dailyStorageCost), which rounds every instance-day to cents. totalPredicted can therefore
+// differ from calculateTotalCostMultipleGpus, which rounds once per fleet row: at 0.0015/hour
+// one instance for 48 hours is predicted as 0.04 + 0.04, against a fleet total of 0.07.
+//
+// Both sides are radix-partitioned on a hash of (model, instance, day) in parallel; each
+// partition then builds an open-addressing table of billed sums and probes it with its
+// predictions, independently of the others. Results don't depend on the thread count.
+ReconciliationReport reconcileBilling(const std::vector<GpuModel>& gpuModels, int runningHours,
+                                      const std::vector<BillingCharge>& charges, double tolerance,
+                                      unsigned threadCount = 0);
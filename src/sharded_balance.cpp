@@ -0,0 +1,198 @@
+#include "sharded_balance.h"
+#include "funds_calculator.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::atomic<unsigned> nextThreadSlot(0);
+
+// Lock-free snapshot passes exactSpentCents tries before taking the drain lock
+const int SNAPSHOT_ATTEMPTS = 8;
+
+// Threads are spread over the shards in the order they first charge
+unsigned threadSlot() {
+    thread_local unsigned slot = nextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+std::int64_t toCents(double amount) {
+    return (std::int64_t)(std::llround(amount * 100.0));
+}
+
+} // namespace
+
+ShardedBalance::ShardedBalance(double initialFunds, std::size_t shardCount, std::int64_t refillCents)
+    : initialCents(toCents(initialFunds)), refillCents(refillCents), shardCount(shardCount),
+      pool(toCents(initialFunds)) {
+    // Input validation
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (refillCents < 0) {
+        throw std::invalid_argument("Refill amount can't be negative");
+    }
+    if (this->shardCount == 0) {
+        this->shardCount = defaultThreadCount();
+    }
+    if (this->refillCents == 0) {
+        this->refillCents = std::max<std::int64_t>(1, initialCents / (std::int64_t)(4 * this->shardCount));
+    }
+    shards.reset(new Shard[this->shardCount]);
+}
+
+bool ShardedBalance::tryCharge(double amount) {
+    if (amount < 0) {
+        throw std::invalid_argument("Charge can't be negative");
+    }
+    return tryChargeCents(toCents(amount));
+}
+
+bool ShardedBalance::tryChargeCents(std::int64_t cents) {
+    if (cents < 0) {
+        throw std::invalid_argument("Charge can't be negative");
+    }
+    if (cents == 0) {
+        return true;
+    }
+
+    Shard& shard = shardForThisThread();
+    do {
+        std::int64_t allowance = shard.allowance.load(std::memory_order_relaxed);
+        while (allowance >= cents) {
+            if (shard.allowance.compare_exchange_weak(allowance, allowance - cents, std::memory_order_acq_rel)) {
+                shard.spent.fetch_add(cents, std::memory_order_release);
+                return true;
+            }
+        }
+    } while (takeFromPool(shard, cents));
+
+    return chargeSlowPath(shard, cents);
+}
+
+ShardedBalance::Shard& ShardedBalance::shardForThisThread() {
+    return shards[threadSlot() % shardCount];
+}
+
+// Move max(refill, cents) from the pool into the shard's allowance; false once the pool is empty
+bool ShardedBalance::takeFromPool(Shard& shard, std::int64_t cents) {
+    std::int64_t wanted = std::max(refillCents, cents);
+    std::int64_t available = pool.load(std::memory_order_relaxed);
+    while (available > 0) {
+        std::int64_t taken = std::min(available, wanted);
+        if (pool.compare_exchange_weak(available, available - taken, std::memory_order_acq_rel)) {
+            shard.allowance.fetch_add(taken, std::memory_order_acq_rel);
+            return taken >= cents || shard.allowance.load(std::memory_order_relaxed) >= cents;
+        }
+    }
+    return false;
+}
+
+// Pool exhausted: gather every shard's unused allowance and charge from the total
+bool ShardedBalance::chargeSlowPath(Shard& shard, std::int64_t cents) {
+    std::lock_guard<std::mutex> lock(drainMutex);
+
+    for (;;) {
+        std::int64_t gathered = 0;
+        for (std::size_t i = 0; i < shardCount; i++) {
+            gathered += shards[i].allowance.exchange(0, std::memory_order_acq_rel);
+        }
+        std::int64_t available = pool.fetch_add(gathered, std::memory_order_acq_rel) + gathered;
+
+        while (available >= cents) {
+            if (pool.compare_exchange_weak(available, available - cents, std::memory_order_acq_rel)) {
+                shard.spent.fetch_add(cents, std::memory_order_release);
+                return true;
+            }
+        }
+        // Another pass only helps if a refill raced with the drain
+        if (gathered == 0) {
+            return false;
+        }
+    }
+}
+
+double ShardedBalance::approximateRemaining() const {
+    std::int64_t spent = 0;
+    for (std::size_t i = 0; i < shardCount; i++) {
+        spent += shards[i].spent.load(std::memory_order_relaxed);
+    }
+    return (double)(initialCents - spent) / 100.0;
+}
+
+double ShardedBalance::exactRemaining() const {
+    return (double)(initialCents - exactSpentCents()) / 100.0;
+}
+
+// Spent counters only grow, so two passes that read the same value from every shard
+// saw a state that really existed between the passes. Under steady charging the passes may
+// never agree, so after a few tries the funds are parked to stop charges and the read is
+// finished under the drain lock.
+std::int64_t ShardedBalance::exactSpentCents() const {
+    std::vector<std::int64_t> seen(shardCount);
+    for (std::size_t i = 0; i < shardCount; i++) {
+        seen[i] = shards[i].spent.load(std::memory_order_acquire);
+    }
+    for (int attempt = 0; attempt < SNAPSHOT_ATTEMPTS; attempt++) {
+        std::int64_t total = 0;
+        if (rereadSpent(seen, total)) {
+            return total;
+        }
+    }
+    return lockedSpentCents(seen);
+}
+
+// Read every shard's spent counter into seen and total; true if none changed since the last read
+bool ShardedBalance::rereadSpent(std::vector<std::int64_t>& seen, std::int64_t& total) const {
+    bool stable = true;
+    total = 0;
+    for (std::size_t i = 0; i < shardCount; i++) {
+        std::int64_t again = shards[i].spent.load(std::memory_order_acquire);
+        if (again != seen[i]) {
+            seen[i] = again;
+            stable = false;
+        }
+        total += again;
+    }
+    return stable;
+}
+
+// With the pool and every allowance parked, charges fall through to chargeSlowPath and wait on
+// the lock, so only charges already past their compare-and-swap can still move the counters
+std::int64_t ShardedBalance::lockedSpentCents(std::vector<std::int64_t>& seen) const {
+    std::lock_guard<std::mutex> lock(drainMutex);
+
+    std::int64_t parked = pool.exchange(0, std::memory_order_acq_rel);
+    std::int64_t total = 0;
+    for (;;) {
+        // A refill that took from the pool before it was parked can still land in an allowance
+        std::int64_t gathered = 0;
+        for (std::size_t i = 0; i < shardCount; i++) {
+            gathered += shards[i].allowance.exchange(0, std::memory_order_acq_rel);
+        }
+        parked += gathered;
+        if (rereadSpent(seen, total) && gathered == 0) {
+            break;
+        }
+    }
+    pool.fetch_add(parked, std::memory_order_acq_rel);
+    return total;
+}
+
+double ShardedBalance::getInitialFunds() const {
+    return (double)(initialCents) / 100.0;
+}
+
+std::size_t ShardedBalance::getShardCount() const {
+    return shardCount;
+}
+
+double calculateRemainingFunds(ShardedBalance& balance, double hourlyRate, int numInstances,
+                               int runningHours, double dailyStorageCost) {
+    double totalCost = calculateTotalCost(hourlyRate, numInstances, runningHours, dailyStorageCost);
+    balance.tryCharge(totalCost);
+    return balance.exactRemaining();
+}
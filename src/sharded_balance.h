@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Wallet balance that many threads can charge at once.
+// Amounts are whole cents. Each shard owns a slice of the unspent funds (its allowance) and
+// a spent counter, both on their own cache line, so a charge is normally one compare-and-swap
+// and one add on the calling thread's shard. Shards refill their allowance from a shared pool
+// in chunks; only when the pool runs dry does a charge take a lock and pull the unused
+// allowances back together.
+class ShardedBalance {
+public:
+    /**
+     * @param initialFunds Opening balance in dollars (rounded to cents)
+     * @param shardCount Number of shards (0 = hardware concurrency)
+     * @param refillCents Allowance a shard takes from the pool at a time (0 = 1/(4 * shards) of the funds, at least 1 cent)
+     */
+    explicit ShardedBalance(double initialFunds, std::size_t shardCount = 0, std::int64_t refillCents = 0);
+
+    ShardedBalance(const ShardedBalance&) = delete;
+    ShardedBalance& operator=(const ShardedBalance&) = delete;
+
+    // Charge amount if the balance covers it. Returns false and leaves the balance unchanged otherwise.
+    // Near exhaustion a charge racing with other refills may be refused although the funds
+    // would just cover it; a charge is never accepted beyond the balance.
+    bool tryCharge(double amount);
+    bool tryChargeCents(std::int64_t cents);
+
+    // Remaining funds from a relaxed sum of the shards; may miss charges still in flight
+    double approximateRemaining() const;
+    // Remaining funds from a consistent snapshot of every shard. Falls back to briefly pausing
+    // charges when concurrent charging keeps the lock-free snapshot from settling.
+    double exactRemaining() const;
+
+    std::int64_t exactSpentCents() const;
+    double getInitialFunds() const;
+    std::size_t getShardCount() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::int64_t> allowance{0};
+        std::atomic<std::int64_t> spent{0};
+    };
+
+    Shard& shardForThisThread();
+    bool takeFromPool(Shard& shard, std::int64_t cents);
+    bool chargeSlowPath(Shard& shard, std::int64_t cents);
+    bool rereadSpent(std::vector<std::int64_t>& seen, std::int64_t& total) const;
+    std::int64_t lockedSpentCents(std::vector<std::int64_t>& seen) const;
+
+    std::int64_t initialCents;
+    std::int64_t refillCents;
+    std::size_t shardCount;
+    std::unique_ptr<Shard[]> shards;
+    // Mutable so exactSpentCents can park the funds while it reads
+    alignas(64) mutable std::atomic<std::int64_t> pool;
+    mutable std::mutex drainMutex;
+};
+
+// calculateRemainingFunds on a shared balance: charges calculateTotalCost(...) and returns the
+// balance after it, or returns the balance unchanged if it does not cover the cost.
+// Under concurrency the returned balance also reflects other threads' charges.
+double calculateRemainingFunds(ShardedBalance& balance, double hourlyRate, int numInstances,
+                               int runningHours, double dailyStorageCost);
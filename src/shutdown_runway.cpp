@@ -0,0 +1,89 @@
+#include "shutdown_runway.h"
+#include "batch_kernels.h"
+#include "funds_calculator.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+ShutdownSchedule calculateShutdownSchedule(double initialFunds, const std::vector<GpuModel>& gpuModels,
+                                           const std::vector<ShutdownRule>& rules) {
+    // Input validation
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    if (rules.size() != gpuModels.size()) {
+        throw std::invalid_argument("Shutdown rules must match the GPU models");
+    }
+    for (std::size_t i = 0; i < gpuModels.size(); i++) {
+        detail::validateFleetRow(gpuModels[i]);
+        if (rules[i].stopBalance < 0) {
+            throw std::invalid_argument("Stop balance can't be negative");
+        }
+    }
+
+    std::size_t count = gpuModels.size();
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (rules[a].stopBalance != rules[b].stopBalance) {
+            return rules[a].stopBalance > rules[b].stopBalance;
+        }
+        if (rules[a].priority != rules[b].priority) {
+            return rules[a].priority < rules[b].priority;
+        }
+        return a < b;
+    });
+
+    // runningRate[k] and runningStorage[k] are the fleet totals while models order[k..] are running
+    std::vector<double> runningRate(count + 1, 0.0);
+    std::vector<double> runningStorage(count + 1, 0.0);
+    for (std::size_t k = count; k-- > 0;) {
+        const GpuModel& gpu = gpuModels[order[k]];
+        runningRate[k] = runningRate[k + 1] + gpu.getHourlyRate() * gpu.getNumInstances();
+        runningStorage[k] = runningStorage[k + 1] + gpu.getDailyStorageCost() * gpu.getNumInstances();
+    }
+
+    ShutdownSchedule schedule;
+    schedule.stopHours.assign(count, -1);
+    schedule.stopOrder.reserve(count);
+
+    double balance = initialFunds;
+    double hour = 0.0;
+    std::size_t next = 0;
+    while (next < count) {
+        double rate = runningRate[next];
+        double storage = runningStorage[next];
+        if (rate <= 0 && storage <= 0) {
+            // The rest of the fleet costs nothing: the balance stays put, so models already at or
+            // below their threshold stop now and the others run indefinitely
+            while (next < count && rules[order[next]].stopBalance >= balance) {
+                schedule.stopHours[order[next]] = hour;
+                schedule.stopOrder.push_back(order[next]);
+                next++;
+            }
+            break;
+        }
+        // Falling to the threshold is running out of (balance - threshold), so the next stop is
+        // found in closed form; one that lands on a day start stops the model before that day's storage
+        double threshold = rules[order[next]].stopBalance;
+        double stopHour = fundsExhaustedAt(hour, balance - threshold, rate, storage);
+        if (stopHour > hour) {
+            double endBalance = balance - spendBetween(hour, stopHour, rate, storage);
+            schedule.segments.push_back(
+                RunwaySegment{hour, stopHour, balance, endBalance, rate, storage, count - next});
+            hour = stopHour;
+            balance = endBalance;
+        }
+        while (next < count && rules[order[next]].stopBalance >= threshold) {
+            schedule.stopHours[order[next]] = hour;
+            schedule.stopOrder.push_back(order[next]);
+            next++;
+        }
+    }
+
+    schedule.runwayHours = next == count ? hour : -1;
+    return schedule;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <cstddef>
+#include <vector>
+
+// Side table entry for one GpuModel: the model is stopped once the balance falls to
+// stopBalance. Among models with the same threshold, lower priority stops first.
+struct ShutdownRule {
+    double stopBalance = 0.0;
+    int priority = 0;
+};
+
+// One stretch of the runway during which the same set of models is running
+struct RunwaySegment {
+    double startHour;
+    double endHour;
+    double startBalance;
+    double endBalance;
+    double hourlyRate;       // running models' hourly rate times instances
+    double dailyStorageCost; // running models' daily storage times instances, charged at each day start
+    std::size_t runningModels;
+};
+
+struct ShutdownSchedule {
+    std::vector<double> stopHours;     // per model in input order; -1 if it never stops
+    std::vector<std::size_t> stopOrder; // model indices in the order they are stopped
+    std::vector<RunwaySegment> segments;
+    double runwayHours;                 // when the last model stops; -1 if some model never stops
+};
+
+// Runway of a fleet that sheds models as the balance crosses their thresholds.
+// Storage is charged at the start of each day as in calculateFundsDurationMultipleGpus, so with
+// no thresholds the runway matches it. A threshold crossed by a day's storage charge stops its
+// models at that day start, before the charge. The schedule is computed with one sort and a
+// sweep over suffix sums of model rates, each segment's end found in closed form.
+// rules[i] applies to gpuModels[i].
+ShutdownSchedule calculateShutdownSchedule(double initialFunds, const std::vector<GpuModel>& gpuModels,
+                                           const std::vector<ShutdownRule>& rules);
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Bounded single-producer/single-consumer ring.
+// The producer only writes tail and the consumer only writes head, so neither side takes a lock.
+// push() blocks while the ring is full, which is what gives a pipeline its backpressure.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Ring capacity must be positive");
+        }
+        std::size_t size = 1;
+        while (size < capacity + 1) {
+            size *= 2;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    bool tryPush(T& value) {
+        std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        std::size_t next = (tail + 1) & mask;
+        if (next == headIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots[tail] = std::move(value);
+        tailIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots[head]);
+        headIndex.store((head + 1) & mask, std::memory_order_release);
+        return true;
+    }
+
+    void push(T value) {
+        while (!tryPush(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Wait for the next value; returns false once the ring is closed and drained
+    bool pop(T& value) {
+        while (!tryPop(value)) {
+            if (closed.load(std::memory_order_acquire)) {
+                // A value pushed just before close() must still be delivered
+                return tryPop(value);
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // Called by the producer after its last push
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+private:
+    std::vector<T> slots;
+    std::size_t mask = 0;
+    alignas(64) std::atomic<std::size_t> headIndex{0};
+    alignas(64) std::atomic<std::size_t> tailIndex{0};
+    std::atomic<bool> closed{false};
+};
@@ -0,0 +1,70 @@
+#include "string_interner.h"
+#include <functional>
+#include <stdexcept>
+
+const std::uint32_t StringInterner::NOT_FOUND;
+
+StringInterner::StringInterner() : slots(64, 0) {
+}
+
+std::uint32_t StringInterner::intern(std::string_view name) {
+    std::size_t hash = std::hash<std::string_view>()(name);
+    std::size_t slot = slotFor(name, hash);
+    if (slots[slot] != 0) {
+        return slots[slot] - 1;
+    }
+
+    std::uint32_t id = (std::uint32_t)(names.size());
+    names.emplace_back(name);
+    hashes.push_back(hash);
+    slots[slot] = id + 1;
+
+    // Keep the load factor at or below one half
+    if (names.size() * 2 > slots.size()) {
+        grow();
+    }
+    return id;
+}
+
+std::uint32_t StringInterner::find(std::string_view name) const {
+    std::size_t slot = slotFor(name, std::hash<std::string_view>()(name));
+    return slots[slot] == 0 ? NOT_FOUND : slots[slot] - 1;
+}
+
+const std::string& StringInterner::nameOf(std::uint32_t id) const {
+    if (id >= names.size()) {
+        throw std::out_of_range("Unknown interned name id");
+    }
+    return names[id];
+}
+
+std::size_t StringInterner::size() const {
+    return names.size();
+}
+
+// Index of the slot holding name, or of the empty slot where it would go
+std::size_t StringInterner::slotFor(std::string_view name, std::size_t hash) const {
+    std::size_t mask = slots.size() - 1;
+    std::size_t slot = hash & mask;
+    while (slots[slot] != 0) {
+        std::uint32_t id = slots[slot] - 1;
+        if (hashes[id] == hash && names[id] == name) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void StringInterner::grow() {
+    std::vector<std::uint32_t> larger(slots.size() * 2, 0);
+    std::size_t mask = larger.size() - 1;
+    for (std::uint32_t id = 0; id < names.size(); id++) {
+        std::size_t slot = hashes[id] & mask;
+        while (larger[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        larger[slot] = id + 1;
+    }
+    slots.swap(larger);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Maps model names to dense ids (0, 1, 2, ...) in first-appearance order.
+// Lookups go through an open-addressing table with linear probing, so interning a name
+// that is already known costs one hash and usually one string compare, with no allocation.
+class StringInterner {
+public:
+    static const std::uint32_t NOT_FOUND = UINT32_MAX;
+
+    StringInterner();
+
+    // Return the id of name, assigning the next free id if it has not been seen
+    std::uint32_t intern(std::string_view name);
+
+    // Return the id of name, or NOT_FOUND
+    std::uint32_t find(std::string_view name) const;
+
+    const std::string& nameOf(std::uint32_t id) const;
+    std::size_t size() const;
+
+private:
+    std::size_t slotFor(std::string_view name, std::size_t hash) const;
+    void grow();
+
+    // Each slot holds id + 1, with 0 marking an empty slot
+    std::vector<std::uint32_t> slots;
+    std::vector<std::size_t> hashes;
+    // deque keeps the strings at stable addresses as the table grows
+    std::deque<std::string> names;
+};
@@ -0,0 +1,212 @@
+#include "tiered_pricing.h"
+#include "funds_calculator.h"
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+} // namespace
+
+TieredRateTable::TieredRateTable(const std::vector<int>& instanceBreakpoints, const std::vector<int>& hourBreakpoints,
+                                 const std::vector<double>& hourlyRates) {
+    // Input validation
+    if (instanceBreakpoints.empty() || hourBreakpoints.empty()) {
+        throw std::invalid_argument("Rate table needs at least one bracket and one tier");
+    }
+    if (instanceBreakpoints.size() > MAX_PRICE_TIERS || hourBreakpoints.size() > MAX_PRICE_TIERS) {
+        throw std::invalid_argument("Rate table can have at most " + std::to_string(MAX_PRICE_TIERS)
+                                    + " brackets and tiers");
+    }
+    if (instanceBreakpoints[0] != 1) {
+        throw std::invalid_argument("Instance brackets must start at 1 and increase");
+    }
+    if (hourBreakpoints[0] != 0) {
+        throw std::invalid_argument("Hour tiers must start at 0 and increase");
+    }
+    for (std::size_t i = 1; i < instanceBreakpoints.size(); i++) {
+        if (instanceBreakpoints[i] <= instanceBreakpoints[i - 1]) {
+            throw std::invalid_argument("Instance brackets must start at 1 and increase");
+        }
+    }
+    for (std::size_t j = 1; j < hourBreakpoints.size(); j++) {
+        if (hourBreakpoints[j] <= hourBreakpoints[j - 1]) {
+            throw std::invalid_argument("Hour tiers must start at 0 and increase");
+        }
+    }
+    if (hourlyRates.size() != instanceBreakpoints.size() * hourBreakpoints.size()) {
+        throw std::invalid_argument("Rate table needs one rate per bracket and tier");
+    }
+    for (double rate : hourlyRates) {
+        if (rate < 0) {
+            throw std::invalid_argument("Hourly rate can't be negative");
+        }
+    }
+
+    // Unused slots are padded so the branch-free counts never select them
+    instanceStarts.fill(INT_MAX);
+    hourStarts.fill(UNREACHABLE);
+    rates.fill(0.0);
+    costAtTierStart.fill(UNREACHABLE);
+    for (std::size_t b = 0; b < instanceBreakpoints.size(); b++) {
+        instanceStarts[b] = instanceBreakpoints[b];
+    }
+    for (std::size_t j = 0; j < hourBreakpoints.size(); j++) {
+        hourStarts[j] = (double)(hourBreakpoints[j]);
+    }
+
+    std::size_t tiers = hourBreakpoints.size();
+    for (std::size_t b = 0; b < instanceBreakpoints.size(); b++) {
+        double cost = 0.0;
+        for (std::size_t j = 0; j < tiers; j++) {
+            rates[b * MAX_PRICE_TIERS + j] = hourlyRates[b * tiers + j];
+            costAtTierStart[b * MAX_PRICE_TIERS + j] = cost;
+            if (j + 1 < tiers) {
+                cost += hourlyRates[b * tiers + j] * (hourStarts[j + 1] - hourStarts[j]);
+            }
+        }
+    }
+}
+
+TieredRateTable::TieredRateTable(double hourlyRate) : TieredRateTable({1}, {0}, {hourlyRate}) {
+}
+
+std::size_t TieredRateTable::bracketOf(int numInstances) const {
+    std::size_t bracket = 0;
+    for (std::size_t k = 1; k < MAX_PRICE_TIERS; k++) {
+        bracket += (std::size_t)(instanceStarts[k] <= numInstances);
+    }
+    return bracket;
+}
+
+std::size_t TieredRateTable::tierOf(double hour) const {
+    std::size_t tier = 0;
+    for (std::size_t k = 1; k < MAX_PRICE_TIERS; k++) {
+        tier += (std::size_t)(hourStarts[k] <= hour);
+    }
+    return tier;
+}
+
+double TieredRateTable::hourlyRateAt(int numInstances, double hour) const {
+    return rates[bracketOf(numInstances) * MAX_PRICE_TIERS + tierOf(hour)];
+}
+
+double TieredRateTable::runtimeCost(int numInstances, double hours) const {
+    std::size_t row = bracketOf(numInstances) * MAX_PRICE_TIERS;
+    std::size_t tier = tierOf(hours);
+    return costAtTierStart[row + tier] + rates[row + tier] * (hours - hourStarts[tier]);
+}
+
+double TieredRateTable::hoursForRuntimeCost(int numInstances, double cost) const {
+    std::size_t row = bracketOf(numInstances) * MAX_PRICE_TIERS;
+    std::size_t tier = 0;
+    for (std::size_t k = 1; k < MAX_PRICE_TIERS; k++) {
+        tier += (std::size_t)(costAtTierStart[row + k] <= cost);
+    }
+    // A free tier before the last would have been skipped by the count, so this is the last tier
+    if (rates[row + tier] <= 0) {
+        return -1;
+    }
+    return hourStarts[tier] + (cost - costAtTierStart[row + tier]) / rates[row + tier];
+}
+
+double calculateTieredTotalCost(const TieredRateTable& rates, int numInstances, int runningHours,
+                                double dailyStorageCost) {
+    // Input validation
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    if (dailyStorageCost < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+    if (numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+
+    double runtimeCost = rates.runtimeCost(numInstances, (double)(runningHours)) * (double)(numInstances);
+    double storageCost = dailyStorageCost * (double)(numInstances) * (double)(calculateRunningDays(runningHours));
+    return std::round((runtimeCost + storageCost) * 100.0) / 100.0;
+}
+
+double calculateTieredTotalCostMultipleGpus(const std::vector<GpuModel>& gpuModels,
+                                            const std::vector<TieredRateTable>& rates, int runningHours) {
+    // Input validation
+    if (gpuModels.empty()) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    if (rates.size() != gpuModels.size()) {
+        throw std::invalid_argument("Rate tables must match the GPU models");
+    }
+    if (runningHours < 0) {
+        throw std::invalid_argument("Running hours can't be negative");
+    }
+    for (const GpuModel& gpu : gpuModels) {
+        detail::validateFleetRow(gpu);
+    }
+
+    std::int64_t totalCents = 0;
+    for (std::size_t i = 0; i < gpuModels.size(); i++) {
+        totalCents += std::llround(calculateTieredTotalCost(rates[i], gpuModels[i].getNumInstances(), runningHours,
+                                                            gpuModels[i].getDailyStorageCost()) * 100.0);
+    }
+    return (double)(totalCents) / 100.0;
+}
+
+double calculateTieredFundsDuration(double initialFunds, const TieredRateTable& rates, int numInstances,
+                                    double dailyStorageCost) {
+    // Input validation
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (numInstances <= 0) {
+        throw std::invalid_argument("Instance count must be positive");
+    }
+    if (dailyStorageCost < 0) {
+        throw std::invalid_argument("Daily storage cost can't be negative");
+    }
+
+    if (initialFunds == 0) {
+        return 0.0;
+    }
+
+    double instances = (double)(numInstances);
+    double storagePerDay = dailyStorageCost * instances;
+
+    // Every tier free: same special cases as calculateFundsDuration with a zero rate
+    if (rates.hoursForRuntimeCost(numInstances, 0.0) < 0) {
+        return storagePerDay <= 0 ? -1 : (initialFunds / storagePerDay) * 24;
+    }
+    if (storagePerDay <= 0) {
+        return rates.hoursForRuntimeCost(numInstances, initialFunds / instances);
+    }
+
+    // Day d can start when its storage and everything before it is affordable: startCost(d) < funds
+    auto startCost = [&](double day) {
+        return rates.runtimeCost(numInstances, 24.0 * day) * instances + storagePerDay * (day + 1.0);
+    };
+    if (startCost(0.0) >= initialFunds) {
+        return 0.0;
+    }
+    double lastDay = 0.0;
+    double tooFar = 1.0;
+    while (startCost(tooFar) < initialFunds) {
+        lastDay = tooFar;
+        tooFar *= 2.0;
+    }
+    while (tooFar - lastDay > 1.0) {
+        double middle = std::floor((lastDay + tooFar) / 2.0);
+        if (startCost(middle) < initialFunds) {
+            lastDay = middle;
+        } else {
+            tooFar = middle;
+        }
+    }
+
+    double runtimeBudget = (initialFunds - storagePerDay * (lastDay + 1.0)) / instances;
+    double hours = rates.hoursForRuntimeCost(numInstances, runtimeBudget);
+    double dayEnd = 24.0 * (lastDay + 1.0);
+    return (hours < 0 || hours > dayEnd) ? dayEnd : hours;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+const std::size_t MAX_PRICE_TIERS = 8;
+
+// Negotiated hourly rates for one GPU model.
+// The instance bracket is chosen by the number of instances rented (volume pricing), and
+// within a bracket the per-instance rate steps down over cumulative running hours like tax
+// brackets: hours in [hourBreakpoints[j], hourBreakpoints[j + 1]) are billed at tier j.
+// Breakpoints and running costs at each breakpoint are precomputed into small fixed-size
+// arrays, and lookups count the breakpoints <= x with a branch-free loop instead of searching.
+class TieredRateTable {
+public:
+    /**
+     * @param instanceBreakpoints Lowest instance count of each bracket, ascending, starting at 1
+     * @param hourBreakpoints First cumulative hour of each tier, ascending, starting at 0
+     * @param hourlyRates Per-instance hourly rates, row-major [bracket][tier]
+     */
+    TieredRateTable(const std::vector<int>& instanceBreakpoints, const std::vector<int>& hourBreakpoints,
+                    const std::vector<double>& hourlyRates);
+
+    // A single rate for every bracket and hour, i.e. the flat GpuModel pricing
+    explicit TieredRateTable(double hourlyRate);
+
+    // Per-instance rate for the hour starting at the given cumulative hour
+    double hourlyRateAt(int numInstances, double hour) const;
+
+    // Per-instance runtime cost of the first `hours` cumulative hours
+    double runtimeCost(int numInstances, double hours) const;
+
+    // Largest number of hours whose per-instance runtime cost is at most cost; -1 if unbounded
+    double hoursForRuntimeCost(int numInstances, double cost) const;
+
+private:
+    std::size_t bracketOf(int numInstances) const;
+    std::size_t tierOf(double hour) const;
+
+    std::array<int, MAX_PRICE_TIERS> instanceStarts;
+    std::array<double, MAX_PRICE_TIERS> hourStarts;
+    std::array<double, MAX_PRICE_TIERS * MAX_PRICE_TIERS> rates;
+    // Per-instance runtime cost of reaching hourStarts[tier], per bracket
+    std::array<double, MAX_PRICE_TIERS * MAX_PRICE_TIERS> costAtTierStart;
+};
+
+// calculateTotalCost with the runtime priced by a rate table
+double calculateTieredTotalCost(const TieredRateTable& rates, int numInstances, int runningHours,
+                                double dailyStorageCost);
+
+// Fleet total; rates[i] prices gpuModels[i] and replaces its flat hourly rate.
+// Rows are summed in cents, like calculateTotalCostMultipleGpus.
+double calculateTieredTotalCostMultipleGpus(const std::vector<GpuModel>& gpuModels,
+                                            const std::vector<TieredRateTable>& rates, int runningHours);
+
+// calculateFundsDuration with the runtime priced by a rate table: storage is paid at the start
+// of each day, then the instances run until funds are gone. Found by bisecting over days and
+// inverting the runtime cost, without stepping through days.
+double calculateTieredFundsDuration(double initialFunds, const TieredRateTable& rates, int numInstances,
+                                    double dailyStorageCost);
@@ -0,0 +1,137 @@
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+std::atomic<bool> tracingEnabled(false);
+
+// One per thread that has recorded a span. Owned by the registry so spans survive the thread.
+struct TraceRing {
+    std::vector<TraceEvent> events = std::vector<TraceEvent>(TRACE_RING_CAPACITY);
+    std::atomic<std::uint64_t> written{0};
+    std::uint32_t threadId;
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<TraceRing>>& registry() {
+    static std::vector<std::unique_ptr<TraceRing>> rings;
+    return rings;
+}
+
+TraceRing& threadRing() {
+    thread_local TraceRing* ring = nullptr;
+    if (ring == nullptr) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry().push_back(std::make_unique<TraceRing>());
+        ring = registry().back().get();
+        ring->threadId = (std::uint32_t)(registry().size());
+    }
+    return *ring;
+}
+
+std::int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if ((unsigned char)(*c) < 0x20) {
+            out << ' ';
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+// Bumped by the operator new hooks in trace_alloc.cpp when they are built in
+thread_local std::uint64_t traceThreadAllocations = 0;
+thread_local std::uint64_t traceThreadAllocatedBytes = 0;
+
+void setTracingEnabled(bool enabled) {
+    tracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isTracingEnabled() {
+    return tracingEnabled.load(std::memory_order_relaxed);
+}
+
+std::uint64_t threadAllocationCount() {
+    return traceThreadAllocations;
+}
+
+std::uint64_t threadAllocatedBytes() {
+    return traceThreadAllocatedBytes;
+}
+
+TraceSpan::TraceSpan(const char* name) : name(name), startNanos(0), startAllocations(0), startBytes(0) {
+    if (isTracingEnabled()) {
+        threadRing();  // so the ring's own allocation on first use isn't charged to this span
+        startAllocations = traceThreadAllocations;
+        startBytes = traceThreadAllocatedBytes;
+        startNanos = nowNanos();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (startNanos == 0) {
+        return;
+    }
+    std::int64_t end = nowNanos();
+    TraceRing& ring = threadRing();
+    std::uint64_t slot = ring.written.load(std::memory_order_relaxed);
+    ring.events[slot % TRACE_RING_CAPACITY] = TraceEvent{name, startNanos, end - startNanos,
+                                                         traceThreadAllocations - startAllocations,
+                                                         traceThreadAllocatedBytes - startBytes, ring.threadId};
+    ring.written.store(slot + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> collectTraceEvents() {
+    std::vector<TraceEvent> events;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& ring : registry()) {
+        std::uint64_t written = ring->written.load(std::memory_order_acquire);
+        std::uint64_t first = written > TRACE_RING_CAPACITY ? written - TRACE_RING_CAPACITY : 0;
+        for (std::uint64_t i = first; i < written; i++) {
+            events.push_back(ring->events[i % TRACE_RING_CAPACITY]);
+        }
+    }
+    return events;
+}
+
+void writeChromeTrace(std::ostream& out) {
+    std::vector<TraceEvent> events = collectTraceEvents();
+    std::int64_t origin = events.empty() ? 0 : events[0].startNanos;
+    for (const TraceEvent& event : events) {
+        origin = std::min(origin, event.startNanos);
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (std::size_t i = 0; i < events.size(); i++) {
+        const TraceEvent& event = events[i];
+        out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        writeJsonString(out, event.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+            << ",\"ts\":" << (double)(event.startNanos - origin) / 1000.0
+            << ",\"dur\":" << (double)(event.durationNanos) / 1000.0
+            << ",\"args\":{\"allocations\":" << event.allocations << ",\"bytes\":" << event.allocatedBytes << "}}";
+    }
+    out << "\n]}\n";
+}
+
+void clearTrace() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& ring : registry()) {
+        ring->written.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Scoped-span tracing with Chrome trace-event output.
+//
+// Code marks spans with TRACE_SCOPE("name"). Only when the tree is configured with
+// -DVASTGPU_TRACING=ON does the macro expand to a TraceSpan; otherwise it expands to
+// nothing, and the operator new/delete hooks in trace_alloc.cpp are not built either.
+// When compiled in, recording still has to be switched on with setTracingEnabled(true).
+//
+// Each thread records into its own fixed-size ring (oldest spans are overwritten), so
+// recording takes no locks. With the allocation hooks built in, every span also records
+// how many allocations and bytes its thread made while the span was open.
+
+struct TraceEvent {
+    const char* name;
+    std::int64_t startNanos;
+    std::int64_t durationNanos;
+    std::uint64_t allocations;
+    std::uint64_t allocatedBytes;
+    std::uint32_t threadId;
+};
+
+const std::size_t TRACE_RING_CAPACITY = 1 << 16;
+
+void setTracingEnabled(bool enabled);
+bool isTracingEnabled();
+
+// Spans recorded so far on all threads, oldest first per thread.
+// Call when the traced threads are idle or joined.
+std::vector<TraceEvent> collectTraceEvents();
+
+// Write the recorded spans as Chrome/Perfetto trace-event JSON ("X" complete events,
+// with allocation counts in args)
+void writeChromeTrace(std::ostream& out);
+
+// Drop every recorded span
+void clearTrace();
+
+// Allocations made so far on the calling thread (always 0 without the hooks)
+std::uint64_t threadAllocationCount();
+std::uint64_t threadAllocatedBytes();
+
+class TraceSpan {
+public:
+    // name must outlive the trace (a string literal)
+    explicit TraceSpan(const char* name);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    std::int64_t startNanos;
+    std::uint64_t startAllocations;
+    std::uint64_t startBytes;
+};
+
+#define VASTGPU_TRACE_CONCAT_INNER(a, b) a##b
+#define VASTGPU_TRACE_CONCAT(a, b) VASTGPU_TRACE_CONCAT_INNER(a, b)
+
+#ifdef VASTGPU_TRACING
+#define TRACE_SCOPE(name) TraceSpan VASTGPU_TRACE_CONCAT(traceSpan, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
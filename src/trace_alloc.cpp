@@ -0,0 +1,58 @@
+// Counting replacements for the global allocation functions, built only with VASTGPU_TRACING.
+// They forward to malloc/free and bump per-thread counters that TraceSpan reads.
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+extern thread_local std::uint64_t traceThreadAllocations;
+extern thread_local std::uint64_t traceThreadAllocatedBytes;
+
+static void* countedAllocate(std::size_t size) {
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    traceThreadAllocations++;
+    traceThreadAllocatedBytes += size;
+    return block;
+}
+
+void* operator new(std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+    std::free(block);
+}
@@ -0,0 +1,260 @@
+#include "tracker_snapshot.h"
+#include "funds_calculator.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File layout: header, then the record array, then the name blob.
+// Every section offset is a multiple of 8 so the records can be used in place.
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t byteOrderMark;
+    double initialFunds;
+    std::int64_t runningTimeHours;
+    SnapshotAggregates aggregates;
+    std::uint64_t modelCount;
+    std::uint64_t recordsOffset;
+    std::uint64_t namesOffset;
+    std::uint64_t namesSize;
+};
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'V', 'G', 'P', 'U', 'S', 'N', 'A', 'P'};
+const std::uint64_t BYTE_ORDER_MARK = 0x0102030405060708ULL;
+
+std::uint64_t alignTo8(std::uint64_t offset) {
+    return (offset + 7) & ~(std::uint64_t)(7);
+}
+
+std::runtime_error snapshotError(const std::string& path, const std::string& message) {
+    return std::runtime_error("Snapshot " + path + ": " + message);
+}
+
+// write() until everything is written; false on error
+bool writeAll(int fd, const char* data, std::size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (std::size_t)(written);
+    }
+    return true;
+}
+
+} // namespace
+
+void saveSnapshot(const std::string& path, const TrackerState& state) {
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_FORMAT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.initialFunds = state.initialFunds;
+    header.runningTimeHours = state.runningTimeHours;
+    header.modelCount = state.gpuModels.size();
+    header.aggregates = SnapshotAggregates{0.0, 0.0, 0};
+
+    std::vector<SnapshotModelRecord> records(state.gpuModels.size());
+    std::string names;
+    for (std::size_t i = 0; i < state.gpuModels.size(); i++) {
+        const GpuModel& gpu = state.gpuModels[i];
+        records[i] = SnapshotModelRecord{gpu.getHourlyRate(), gpu.getDailyStorageCost(), gpu.getNumInstances(),
+                                         (std::uint32_t)(gpu.getName().size()), names.size()};
+        names += gpu.getName();
+
+        header.aggregates.totalHourlyRate += gpu.getHourlyRate() * gpu.getNumInstances();
+        header.aggregates.totalDailyStorageCost += gpu.getDailyStorageCost() * gpu.getNumInstances();
+        header.aggregates.totalInstances += gpu.getNumInstances();
+    }
+
+    header.recordsOffset = alignTo8(sizeof(SnapshotHeader));
+    header.namesOffset = alignTo8(header.recordsOffset + records.size() * sizeof(SnapshotModelRecord));
+    header.namesSize = names.size();
+
+    std::string contents;
+    contents.reserve(header.namesOffset + names.size());
+    contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    contents.resize(header.recordsOffset, '\0');
+    contents.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SnapshotModelRecord));
+    contents.resize(header.namesOffset, '\0');
+    contents += names;
+
+    // A unique temp file per save, so concurrent saves to one path can't write into each
+    // other's temp file; the last rename wins with a complete snapshot
+    std::string tempPath = path + ".XXXXXX";
+    int fd = ::mkstemp(&tempPath[0]);
+    if (fd < 0) {
+        throw snapshotError(path, std::string("can't create temp file: ") + std::strerror(errno));
+    }
+    auto fail = [&](const std::string& message) {
+        ::close(fd);
+        ::unlink(tempPath.c_str());
+        return snapshotError(tempPath, message);
+    };
+    // mkstemp creates the file 0600; snapshots are meant to be readable like other outputs
+    if (::fchmod(fd, 0644) != 0) {
+        throw fail(std::strerror(errno));
+    }
+    if (!writeAll(fd, contents.data(), contents.size())) {
+        throw fail(std::string("write failed: ") + std::strerror(errno));
+    }
+    // The data must be on disk before the rename is, or a crash could leave an empty file at path
+    if (::fsync(fd) != 0) {
+        throw fail(std::string("fsync failed: ") + std::strerror(errno));
+    }
+    if (::close(fd) != 0) {
+        int error = errno;
+        ::unlink(tempPath.c_str());
+        throw snapshotError(tempPath, std::strerror(error));
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        int error = errno;
+        ::unlink(tempPath.c_str());
+        throw snapshotError(path, std::strerror(error));
+    }
+
+    // Persist the rename itself; best effort, since the new snapshot is already in place
+    std::size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int directoryFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (directoryFd >= 0) {
+        ::fsync(directoryFd);
+        ::close(directoryFd);
+    }
+}
+
+SnapshotView::SnapshotView(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw snapshotError(path, std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw snapshotError(path, std::strerror(error));
+    }
+    length = (std::size_t)(info.st_size);
+    if (length < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        throw snapshotError(path, "file is too small");
+    }
+
+    void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw snapshotError(path, std::strerror(errno));
+    }
+    data = static_cast<const unsigned char*>(mapped);
+    header = reinterpret_cast<const SnapshotHeader*>(data);
+
+    try {
+        if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            throw snapshotError(path, "not a tracker snapshot");
+        }
+        if (header->byteOrderMark != BYTE_ORDER_MARK) {
+            throw snapshotError(path, "written on a machine with a different byte order");
+        }
+        if (header->version != SNAPSHOT_FORMAT_VERSION || header->headerSize != sizeof(SnapshotHeader)) {
+            throw snapshotError(path, "unsupported format version " + std::to_string(header->version));
+        }
+
+        std::uint64_t recordBytes = header->modelCount * sizeof(SnapshotModelRecord);
+        if (header->modelCount > length / sizeof(SnapshotModelRecord)
+            || header->recordsOffset % 8 != 0 || header->recordsOffset > length
+            || recordBytes > length - header->recordsOffset
+            || header->namesOffset > length || header->namesSize > length - header->namesOffset) {
+            throw snapshotError(path, "truncated or corrupt");
+        }
+
+        records = reinterpret_cast<const SnapshotModelRecord*>(data + header->recordsOffset);
+        names = reinterpret_cast<const char*>(data + header->namesOffset);
+        for (std::size_t i = 0; i < header->modelCount; i++) {
+            if (records[i].nameOffset > header->namesSize
+                || records[i].nameLength > header->namesSize - records[i].nameOffset) {
+                throw snapshotError(path, "truncated or corrupt");
+            }
+        }
+    } catch (...) {
+        ::munmap(const_cast<unsigned char*>(data), length);
+        throw;
+    }
+}
+
+SnapshotView::~SnapshotView() {
+    ::munmap(const_cast<unsigned char*>(data), length);
+}
+
+double SnapshotView::getInitialFunds() const {
+    return header->initialFunds;
+}
+
+int SnapshotView::getRunningTimeHours() const {
+    return (int)(header->runningTimeHours);
+}
+
+const SnapshotAggregates& SnapshotView::getAggregates() const {
+    return header->aggregates;
+}
+
+std::size_t SnapshotView::size() const {
+    return header->modelCount;
+}
+
+const SnapshotModelRecord* SnapshotView::begin() const {
+    return records;
+}
+
+const SnapshotModelRecord* SnapshotView::end() const {
+    return records + header->modelCount;
+}
+
+std::string_view SnapshotView::nameOf(std::size_t index) const {
+    if (index >= header->modelCount) {
+        throw std::out_of_range("Snapshot model index out of range");
+    }
+    return std::string_view(names + records[index].nameOffset, records[index].nameLength);
+}
+
+double SnapshotView::cachedFundsDuration() const {
+    const SnapshotAggregates& totals = header->aggregates;
+    if (header->initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    if (header->modelCount == 0) {
+        throw std::invalid_argument("GPU models list can't be empty");
+    }
+    if (header->initialFunds == 0) {
+        return 0.0;
+    }
+    if (totals.totalHourlyRate <= 0 && totals.totalDailyStorageCost <= 0) {
+        return -1;
+    }
+    return calculateFundsDuration(header->initialFunds, totals.totalHourlyRate, 1, totals.totalDailyStorageCost);
+}
+
+TrackerState SnapshotView::toState() const {
+    TrackerState state;
+    state.initialFunds = header->initialFunds;
+    state.runningTimeHours = (int)(header->runningTimeHours);
+    state.gpuModels.reserve(header->modelCount);
+    for (std::size_t i = 0; i < header->modelCount; i++) {
+        state.gpuModels.emplace_back(std::string(nameOf(i)), records[i].hourlyRate,
+                                     records[i].dailyStorageCost, records[i].numInstances);
+    }
+    return state;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "gpu_model.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Everything the interactive tracker asks for at its prompts
+struct TrackerState {
+    double initialFunds = 0.0;
+    int runningTimeHours = 0;
+    std::vector<GpuModel> gpuModels;
+};
+
+// Fleet totals stored alongside the rows so a restore does not have to re-sum the fleet
+struct SnapshotAggregates {
+    double totalHourlyRate;        // sum of hourlyRate * numInstances
+    double totalDailyStorageCost;  // sum of dailyStorageCost * numInstances
+    std::int64_t totalInstances;
+};
+
+// One fleet row as laid out in the snapshot file.
+// It has the GpuModel getters, so the range calculators in funds_calculator.h can run
+// directly over the mapped records.
+struct SnapshotModelRecord {
+    double hourlyRate;
+    double dailyStorageCost;
+    std::int32_t numInstances;
+    std::uint32_t nameLength;
+    std::uint64_t nameOffset;  // into the name blob
+
+    double getHourlyRate() const { return hourlyRate; }
+    double getDailyStorageCost() const { return dailyStorageCost; }
+    int getNumInstances() const { return numInstances; }
+};
+
+const std::uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+
+struct SnapshotHeader;
+
+// Write state to path. The file is written to a uniquely named temp file next to path, synced
+// and renamed into place, so a reader (or a restart after a crash) never sees a half-written
+// snapshot and concurrent saves don't interfere. Throws std::runtime_error on I/O failure.
+void saveSnapshot(const std::string& path, const TrackerState& state);
+
+// Read-only view of a snapshot file mapped into memory.
+// Opening checks the magic, format version, byte order and that every section and name lies
+// inside the file; it throws std::runtime_error otherwise. Nothing is parsed or copied.
+class SnapshotView {
+public:
+    explicit SnapshotView(const std::string& path);
+    ~SnapshotView();
+
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+
+    double getInitialFunds() const;
+    int getRunningTimeHours() const;
+    const SnapshotAggregates& getAggregates() const;
+
+    std::size_t size() const;
+    const SnapshotModelRecord* begin() const;
+    const SnapshotModelRecord* end() const;
+    std::string_view nameOf(std::size_t index) const;
+
+    // Same result as calculateFundsDurationMultipleGpus over the stored fleet, from the cached totals
+    double cachedFundsDuration() const;
+
+    // Copy the snapshot back into a TrackerState
+    TrackerState toState() const;
+
+private:
+    const unsigned char* data = nullptr;
+    std::size_t length = 0;
+    const SnapshotHeader* header = nullptr;
+    const SnapshotModelRecord* records = nullptr;
+    const char* names = nullptr;
+};
@@ -0,0 +1,221 @@
+#include "usage_log_watch.h"
+#include "fleet_csv.h"
+#include "funds_calculator.h"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+UsageLogFollower::UsageLogFollower(const std::string& path, double initialFunds)
+    : path(path), remainingFunds(initialFunds) {
+    if (initialFunds < 0) {
+        throw std::invalid_argument("Initial funds can't be negative");
+    }
+    openLog();
+}
+
+UsageLogFollower::~UsageLogFollower() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool UsageLogFollower::openLog() {
+    if (fd < 0) {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    return fd >= 0;
+}
+
+std::size_t UsageLogFollower::poll() {
+    if (!openLog()) {
+        return 0;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        throw std::runtime_error("Usage log " + path + ": " + std::strerror(errno));
+    }
+    std::uint64_t size = (std::uint64_t)(info.st_size);
+    if (size < offset) {
+        throw std::runtime_error("Usage log " + path + " shrank; it must be append-only");
+    }
+
+    std::size_t applied = recordCount + errorCount;
+    char buffer[1 << 16];
+    while (offset < size) {
+        ssize_t got = ::pread(fd, buffer, sizeof(buffer), (off_t)(offset));
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Usage log " + path + ": " + std::strerror(errno));
+        }
+        if (got == 0) {
+            break;
+        }
+        offset += (std::uint64_t)(got);
+
+        const char* begin = buffer;
+        const char* end = buffer + got;
+        while (begin < end) {
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', (std::size_t)(end - begin)));
+            if (newline == nullptr) {
+                pending.append(begin, end);
+                break;
+            }
+            pending.append(begin, newline);
+            applyLine(pending);
+            pending.clear();
+            begin = newline + 1;
+        }
+    }
+    return recordCount + errorCount - applied;
+}
+
+void UsageLogFollower::applyLine(const std::string& line) {
+    lineNumber++;
+    if (line.empty() || line == "\r" || line[0] == '#') {
+        return;
+    }
+
+    // The last field is the billed hours; the rest is a fleet CSV row
+    std::size_t comma = line.rfind(',');
+    FleetCsvFields fields;
+    std::string error;
+    int hours = 0;
+    if (comma == std::string::npos) {
+        error = "Expected 5 comma-separated fields";
+    } else {
+        const char* first = line.data() + comma + 1;
+        const char* last = line.data() + line.size();
+        while (first < last && *first == ' ') {
+            first++;
+        }
+        while (last > first && (last[-1] == ' ' || last[-1] == '\r')) {
+            last--;
+        }
+        std::from_chars_result result = std::from_chars(first, last, hours);
+        if (result.ec != std::errc() || result.ptr != last || first == last) {
+            error = "Invalid hours";
+        } else if (hours < 0) {
+            error = "Running hours can't be negative";
+        } else if (!parseFleetCsvFields(std::string_view(line).substr(0, comma), fields, error)
+                   && error == "Expected 4 comma-separated fields") {
+            error = "Expected 5 comma-separated fields";
+        }
+    }
+    if (!error.empty()) {
+        errorCount++;
+        lastError = "line " + std::to_string(lineNumber) + ": " + error;
+        return;
+    }
+
+    double charge = calculateTotalCost(fields.hourlyRate, fields.numInstances, hours, fields.dailyStorageCost);
+    remainingFunds = calculateRemainingFunds(remainingFunds, charge);
+    totalCharged += charge;
+    currentUsage[std::string(fields.name)] = ModelUsage{fields.hourlyRate, fields.dailyStorageCost,
+                                                        fields.numInstances};
+    recordCount++;
+}
+
+const std::string& UsageLogFollower::getPath() const {
+    return path;
+}
+
+double UsageLogFollower::getRemainingFunds() const {
+    return remainingFunds;
+}
+
+double UsageLogFollower::getTotalCharged() const {
+    return totalCharged;
+}
+
+double UsageLogFollower::getProjectedRunway() const {
+    if (remainingFunds <= 0) {
+        return 0.0;
+    }
+
+    double totalHourlyRate = 0.0;
+    double totalDailyStorageCost = 0.0;
+    for (const auto& entry : currentUsage) {
+        totalHourlyRate += entry.second.hourlyRate * entry.second.numInstances;
+        totalDailyStorageCost += entry.second.dailyStorageCost * entry.second.numInstances;
+    }
+    return calculateFundsDuration(remainingFunds, totalHourlyRate, 1, totalDailyStorageCost);
+}
+
+std::size_t UsageLogFollower::getRecordCount() const {
+    return recordCount;
+}
+
+std::size_t UsageLogFollower::getErrorCount() const {
+    return errorCount;
+}
+
+const std::string& UsageLogFollower::getLastError() const {
+    return lastError;
+}
+
+std::uint64_t UsageLogFollower::getOffset() const {
+    return offset;
+}
+
+void watchUsageLog(UsageLogFollower& follower, const std::function<void(const UsageLogFollower&)>& onUpdate,
+                   const std::atomic<bool>& stop) {
+    int inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        throw std::runtime_error(std::string("inotify unavailable: ") + std::strerror(errno));
+    }
+
+    // Watch the directory rather than the file so a log that does not exist yet is picked up
+    const std::string& path = follower.getPath();
+    std::size_t slash = path.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    std::string fileName = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    if (::inotify_add_watch(inotifyFd, directory.c_str(), IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE) < 0) {
+        int error = errno;
+        ::close(inotifyFd);
+        throw std::runtime_error("Can't watch " + directory + ": " + std::strerror(error));
+    }
+
+    try {
+        if (follower.poll() > 0) {
+            onUpdate(follower);
+        }
+
+        alignas(struct inotify_event) char events[4096];
+        while (!stop.load()) {
+            struct pollfd waitFor = {inotifyFd, POLLIN, 0};
+            // Wake up periodically to notice stop
+            if (::poll(&waitFor, 1, 100) <= 0) {
+                continue;
+            }
+
+            bool touched = false;
+            ssize_t got;
+            while ((got = ::read(inotifyFd, events, sizeof(events))) > 0) {
+                for (char* p = events; p < events + got;) {
+                    struct inotify_event* event = reinterpret_cast<struct inotify_event*>(p);
+                    if (event->len > 0 && fileName == event->name) {
+                        touched = true;
+                    }
+                    p += sizeof(struct inotify_event) + event->len;
+                }
+            }
+            if (touched && follower.poll() > 0) {
+                onUpdate(follower);
+            }
+        }
+    } catch (...) {
+        ::close(inotifyFd);
+        throw;
+    }
+    ::close(inotifyFd);
+}
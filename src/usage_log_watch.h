@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+// Follows an append-only usage log and keeps remaining funds and runway current.
+// Each log line records one charge:
+//     name,hourlyRate,dailyStorageCost,numInstances,hours
+// charged as calculateTotalCost(hourlyRate, numInstances, hours, dailyStorageCost).
+// The latest line per model name is that model's current configuration for the runway forecast.
+class UsageLogFollower {
+public:
+    /**
+     * @param path Log file to follow; it may not exist yet
+     * @param initialFunds Funds before the first line of the log
+     */
+    UsageLogFollower(const std::string& path, double initialFunds);
+    ~UsageLogFollower();
+
+    UsageLogFollower(const UsageLogFollower&) = delete;
+    UsageLogFollower& operator=(const UsageLogFollower&) = delete;
+
+    // Read only the bytes appended since the last call and apply every complete line.
+    // Returns the number of lines applied. Throws std::runtime_error if the file shrank.
+    std::size_t poll();
+
+    const std::string& getPath() const;
+    double getRemainingFunds() const;
+    double getTotalCharged() const;
+    // Hours the remaining funds last at the current fleet configuration; -1 if nothing is billing
+    double getProjectedRunway() const;
+    std::size_t getRecordCount() const;
+    std::size_t getErrorCount() const;
+    const std::string& getLastError() const;
+    std::uint64_t getOffset() const;
+
+private:
+    struct ModelUsage {
+        double hourlyRate;
+        double dailyStorageCost;
+        int numInstances;
+    };
+
+    bool openLog();
+    void applyLine(const std::string& line);
+
+    std::string path;
+    int fd = -1;
+    std::uint64_t offset = 0;
+    std::string pending;  // bytes after the last newline
+
+    double remainingFunds;
+    double totalCharged = 0.0;
+    std::size_t lineNumber = 0;
+    std::size_t recordCount = 0;
+    std::size_t errorCount = 0;
+    std::string lastError;
+    std::unordered_map<std::string, ModelUsage> currentUsage;
+};
+
+// Block on inotify until stop is set, calling follower.poll() whenever the log changes and
+// onUpdate after every poll that applied at least one line. Throws std::runtime_error if
+// inotify is unavailable.
+void watchUsageLog(UsageLogFollower& follower, const std::function<void(const UsageLogFollower&)>& onUpdate,
+                   const std::atomic<bool>& stop);
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../src/batch_kernels.h"
+#include "../src/funds_calculator.h"
+
+const double EPSILON = 0.001;
+
+// 1. Batch runway kernel against the scalar calculator
+TEST(CalculateFundsDurationBatch, MatchesScalarOnMixedCatalog) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> funds(0.0, 10000.0);
+    std::uniform_real_distribution<double> rate(0.0, 5.0);
+    std::uniform_real_distribution<double> storage(0.0, 3.0);
+    std::uniform_int_distribution<int> instances(1, 10);
+    std::uniform_int_distribution<int> pick(0, 5);
+
+    std::vector<double> initialFunds, hourlyRates, dailyStorageCosts;
+    std::vector<int> instanceCounts;
+    for (int i = 0; i < 20000; i++) {
+        int kind = pick(rng);
+        initialFunds.push_back(kind == 0 ? 0.0 : funds(rng));
+        hourlyRates.push_back(kind == 1 || kind == 2 ? 0.0 : rate(rng));      // idle storage boxes
+        dailyStorageCosts.push_back(kind == 1 || kind == 3 ? 0.0 : storage(rng)); // compute-only boxes
+        instanceCounts.push_back(instances(rng));
+    }
+
+    std::vector<double> durations(initialFunds.size());
+    calculateFundsDurationBatch(initialFunds.data(), hourlyRates.data(), instanceCounts.data(),
+                                dailyStorageCosts.data(), initialFunds.size(), durations.data());
+
+    // TC1-TC5: Every case agrees with calculateFundsDuration, in input order
+    for (std::size_t i = 0; i < durations.size(); i++) {
+        double expected = calculateFundsDuration(initialFunds[i], hourlyRates[i], instanceCounts[i],
+                                                 dailyStorageCosts[i]);
+        ASSERT_NEAR(expected, durations[i], EPSILON) << "row " << i;
+    }
+}
+
+TEST(CalculateFundsDurationBatch, BoundaryValues) {
+    // Values from the scalar boundary tests, including exact day boundaries
+    std::vector<double> initialFunds = {1000.0, 0.01, 10000.0, 1000.0, 1000.0, 1000.0, 1000.0, 122.5, 245.0};
+    std::vector<double> hourlyRates = {1.0, 1.0, 1.0, 0.0, 0.01, 10.0, 1.0, 1.0, 1.0};
+    std::vector<int> instanceCounts = {5, 5, 5, 5, 5, 5, 100, 5, 5};
+    std::vector<double> dailyStorageCosts = {0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5};
+    std::vector<double> expected = {195.5, 0.0, 1959.0, 9600.0, 6480.0, 19.95, 9.5, 24.0, 48.0};
+
+    std::vector<double> durations(initialFunds.size());
+    calculateFundsDurationBatch(initialFunds.data(), hourlyRates.data(), instanceCounts.data(),
+                                dailyStorageCosts.data(), initialFunds.size(), durations.data());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        EXPECT_NEAR(expected[i], durations[i], EPSILON) << "row " << i;
+        EXPECT_NEAR(calculateFundsDuration(initialFunds[i], hourlyRates[i], instanceCounts[i], dailyStorageCosts[i]),
+                    durations[i], EPSILON) << "row " << i;
+    }
+
+    // TC: Empty batch is a no-op
+    calculateFundsDurationBatch(nullptr, nullptr, nullptr, nullptr, 0, nullptr);
+}
+
+TEST(CalculateFundsDurationBatch, InputValidation) {
+    double funds[] = {100.0, -1.0};
+    double rates[] = {1.0, 1.0};
+    int instances[] = {1, 1};
+    double storage[] = {0.5, 0.5};
+    double out[2];
+
+    // TC1: Negative funds anywhere in the batch
+    EXPECT_THROW(calculateFundsDurationBatch(funds, rates, instances, storage, 2, out), std::invalid_argument);
+
+    // TC2: Non-positive instances, negative rate, negative storage
+    funds[1] = 1.0;
+    instances[1] = 0;
+    EXPECT_THROW(calculateFundsDurationBatch(funds, rates, instances, storage, 2, out), std::invalid_argument);
+    instances[1] = 1;
+    rates[1] = -1.0;
+    EXPECT_THROW(calculateFundsDurationBatch(funds, rates, instances, storage, 2, out), std::invalid_argument);
+    rates[1] = 1.0;
+    storage[1] = -0.5;
+    EXPECT_THROW(calculateFundsDurationBatch(funds, rates, instances, storage, 2, out), std::invalid_argument);
+}
+
+// 2. Closed-form fleet runway
+TEST(ClosedFormFundsDuration, MatchesMultipleGpus) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2), GpuModel("Test2", 3.0, 1.5, 3)};
+
+    // TC1: Fleet totals give the multi-GPU runway
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(1000.0, gpuModels), closedFormFundsDuration(1000.0, 13.0, 6.5), EPSILON);
+
+    // TC2: Special cases
+    EXPECT_NEAR(0.0, closedFormFundsDuration(0.0, 13.0, 6.5), EPSILON);
+    EXPECT_NEAR(-1.0, closedFormFundsDuration(100.0, 0.0, 0.0), EPSILON);
+    EXPECT_THROW(closedFormFundsDuration(-1.0, 1.0, 1.0), std::invalid_argument);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "../src/bench_stats.h"
+
+const double EPSILON = 0.001;
+
+namespace {
+
+// Timings around a typical value with occasional slow outliers, like a busy machine
+std::vector<double> noisyTimings(double typical, std::size_t count, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> jitter(0.0, typical * 0.05);
+    std::uniform_int_distribution<int> outlier(0, 9);
+    std::vector<double> samples;
+    for (std::size_t i = 0; i < count; i++) {
+        samples.push_back(typical + jitter(rng) + (outlier(rng) == 0 ? typical : 0.0));
+    }
+    return samples;
+}
+
+} // namespace
+
+// 1. JSON round trip
+TEST(BenchmarkJson, RoundTrip) {
+    std::vector<BenchmarkSamples> benchmarks = {{"calculateTotalCost", {12.5, 12.75, 13.0}},
+                                                {"PricingRule::\"quoted\"", {}}};
+    std::stringstream json;
+    writeBenchmarkJson(json, benchmarks);
+
+    // TC1: Names and samples survive
+    std::vector<BenchmarkSamples> read = readBenchmarkJson(json);
+    ASSERT_EQ(2u, read.size());
+    EXPECT_EQ("calculateTotalCost", read[0].name);
+    ASSERT_EQ(3u, read[0].nanosPerCall.size());
+    EXPECT_NEAR(12.75, read[0].nanosPerCall[1], EPSILON);
+    EXPECT_EQ("PricingRule::\"quoted\"", read[1].name);
+    EXPECT_TRUE(read[1].nanosPerCall.empty());
+
+    // TC2: Malformed input
+    std::stringstream truncated("{\"benchmarks\": [{\"name\": \"x\", \"ns_per_call\": [1,");
+    EXPECT_THROW(readBenchmarkJson(truncated), std::runtime_error);
+    std::stringstream unknown("{\"benchmarks\": [{\"nom\": \"x\"}]}");
+    EXPECT_THROW(readBenchmarkJson(unknown), std::runtime_error);
+}
+
+// 2. Statistics
+TEST(BenchmarkStats, MedianAndRankTest) {
+    // TC1: Odd and even medians
+    EXPECT_NEAR(2.0, sampleMedian({3.0, 1.0, 2.0}), EPSILON);
+    EXPECT_NEAR(2.5, sampleMedian({4.0, 1.0, 3.0, 2.0}), EPSILON);
+
+    // TC2: Fully separated samples of 5 and 5 (exact one-sided p = 1/252)
+    double p = mannWhitneySlowerPValue({1, 2, 3, 4, 5}, {6, 7, 8, 9, 10});
+    EXPECT_LT(p, 0.01);
+    EXPECT_GT(mannWhitneySlowerPValue({6, 7, 8, 9, 10}, {1, 2, 3, 4, 5}), 0.99);
+
+    // TC3: Identical samples can't be told apart
+    EXPECT_NEAR(1.0, mannWhitneySlowerPValue({5, 5, 5}, {5, 5, 5}), EPSILON);
+}
+
+TEST(BenchmarkStats, BootstrapInterval) {
+    std::vector<double> before = noisyTimings(100.0, 30, 1);
+    std::vector<double> after = noisyTimings(300.0, 30, 2);
+
+    // TC1: The interval brackets the 3x ratio, and the same seed gives the same interval
+    RatioInterval interval = bootstrapMedianRatio(before, after, 2000, 0.99, 7);
+    EXPECT_LT(interval.low, 3.0);
+    EXPECT_GT(interval.high, 3.0);
+    EXPECT_GT(interval.low, 2.5);
+    RatioInterval again = bootstrapMedianRatio(before, after, 2000, 0.99, 7);
+    EXPECT_EQ(interval.low, again.low);
+    EXPECT_EQ(interval.high, again.high);
+
+    // TC2: Invalid parameters
+    EXPECT_THROW(bootstrapMedianRatio(before, after, 0, 0.99, 7), std::invalid_argument);
+    EXPECT_THROW(bootstrapMedianRatio(before, after, 100, 1.0, 7), std::invalid_argument);
+}
+
+// 3. Comparing runs
+TEST(CompareBenchmarks, FlagsOnlyRealSlowdowns) {
+    std::vector<BenchmarkSamples> before = {{"calculateFundsDurationMultipleGpus", noisyTimings(100.0, 20, 1)},
+                                            {"calculateTotalCost", noisyTimings(10.0, 20, 3)},
+                                            {"removedKernel", noisyTimings(10.0, 20, 5)}};
+    std::vector<BenchmarkSamples> after = {{"calculateTotalCost", noisyTimings(10.0, 20, 4)},
+                                           {"calculateFundsDurationMultipleGpus", noisyTimings(300.0, 20, 2)}};
+
+    std::vector<BenchmarkComparison> comparisons = compareBenchmarks(before, after);
+
+    // TC1: The 3x slowdown is flagged, same-speed noise isn't, and unmatched kernels are skipped
+    ASSERT_EQ(2u, comparisons.size());
+    EXPECT_EQ("calculateFundsDurationMultipleGpus", comparisons[0].name);
+    EXPECT_TRUE(comparisons[0].regressed);
+    EXPECT_NEAR(3.0, comparisons[0].ratio, 0.3);
+    EXPECT_FALSE(comparisons[1].regressed);
+
+    // TC2: A slowdown under the threshold isn't a regression
+    BenchmarkCompareConfig lenient;
+    lenient.maxSlowdown = 4.0;
+    EXPECT_FALSE(compareBenchmarks(before, after, lenient)[0].regressed);
+
+    // TC3: One sample per run isn't enough to decide
+    std::vector<BenchmarkSamples> single = {{"calculateTotalCost", {10.0}}};
+    EXPECT_THROW(compareBenchmarks(single, single), std::invalid_argument);
+}
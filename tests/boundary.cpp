@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <vector>
 #include <cmath>
 #include "../src/funds_calculator.h"
@@ -162,6 +164,54 @@ TEST(CalculateTotalCostMultipleGpusTest, BoundaryValueTests) {
     EXPECT_NEAR(13273.0, calculateTotalCostMultipleGpus(gpuModels, 1000), EPSILON);  // TC9: max (simulate an imaginary maximum value)
 }
 
+// 3.4.1. calculateTotalCostMultipleGpus on fleets large enough to sum in parallel
+TEST(CalculateTotalCostMultipleGpusTest, LargeFleetTotalIsDeterministic) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> rate(0.0, 4.0);
+    std::uniform_real_distribution<double> storage(0.0, 2.0);
+    std::uniform_int_distribution<int> instances(1, 8);
+
+    std::vector<GpuModel> gpuModels;
+    for (std::size_t i = 0; i < PARALLEL_TOTAL_MIN_ROWS + 12345; i++) {
+        gpuModels.push_back(GpuModel("GPU", rate(rng), storage(rng), instances(rng)));
+    }
+
+    // TC1: Same bits on one thread and on several
+    double serial = calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), 50, 1);
+    EXPECT_EQ(serial, calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), 50, 3));
+    EXPECT_EQ(serial, calculateTotalCostMultipleGpus(gpuModels, 50));
+
+    // TC2: Same bits after reordering the fleet
+    std::shuffle(gpuModels.begin(), gpuModels.end(), rng);
+    EXPECT_EQ(serial, calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), 50, 4));
+    EXPECT_EQ(serial, calculateTotalCostMultipleGpus(gpuModels.rbegin(), gpuModels.rend(), 50, 2));
+
+    // TC3: The earliest invalid row decides the error, whichever thread sees it
+    gpuModels[PARALLEL_TOTAL_MIN_ROWS - 5] = GpuModel("Bad", 1.0, -0.5, 1);
+    gpuModels[PARALLEL_TOTAL_MIN_ROWS + 5] = GpuModel("Bad", -1.0, 0.5, 1);
+    try {
+        calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), 50, 4);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ("GPU daily storage cost can't be negative", e.what());
+    }
+
+    // TC4: A NaN row throws on every path instead of truncating the parallel sum
+    gpuModels[PARALLEL_TOTAL_MIN_ROWS - 5] = GpuModel("GPU", 1.0, 0.5, 1);
+    gpuModels[PARALLEL_TOTAL_MIN_ROWS + 5] = GpuModel("GPU", 1.0, 0.5, 1);
+    gpuModels[PARALLEL_TOTAL_MIN_ROWS + 100] = GpuModel("NaN", std::nan(""), 0.5, 1);
+    EXPECT_THROW(calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), 50, 4), std::invalid_argument);
+    EXPECT_THROW(calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), 50, 1), std::invalid_argument);
+    gpuModels[PARALLEL_TOTAL_MIN_ROWS + 100] = GpuModel("NaN", 1.0, std::nan(""), 1);
+    try {
+        calculateTotalCostMultipleGpus(gpuModels.begin(), gpuModels.end(), 50, 4);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ("GPU daily storage cost must be finite", e.what());
+    }
+    EXPECT_THROW(calculateFundsDurationMultipleGpus(100.0, gpuModels), std::invalid_argument);
+}
+
 // 3.5. calculateFundsDurationMultipleGpus Boundary Value Tests
 TEST(CalculateFundsDurationMultipleGpusTest, BoundaryValueTests) {
     std::vector<GpuModel> gpuModels;
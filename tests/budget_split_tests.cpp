@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../src/budget_split.h"
+#include "../src/funds_calculator.h"
+
+const double EPSILON = 0.001;
+
+// 1. Equal runway
+TEST(SplitBudgetEqualRunway, EqualisesRunway) {
+    std::vector<std::vector<GpuModel>> projects = {
+        {GpuModel("Test1", 2.0, 1.0, 2), GpuModel("Test2", 3.0, 1.5, 3)},
+        {GpuModel("Test3", 1.0, 0.5, 5)},
+        {GpuModel("Test4", 0.0, 2.0, 1)}};
+
+    BudgetSplit split = splitBudgetEqualRunway(10000.0, projects);
+
+    // TC1: Every share buys the same runway, checked with the fleet calculator
+    double runway = split.runwayHours[0];
+    EXPECT_GT(runway, 0.0);
+    for (std::size_t i = 0; i < projects.size(); i++) {
+        EXPECT_NEAR(runway, split.runwayHours[i], EPSILON);
+        EXPECT_NEAR(runway, calculateFundsDurationMultipleGpus(split.funds[i], projects[i]), EPSILON) << "project " << i;
+    }
+
+    // TC2: The pool is spent, short of at most one more day of storage
+    double allocated = split.funds[0] + split.funds[1] + split.funds[2];
+    EXPECT_NEAR(10000.0, allocated + split.unallocated, EPSILON);
+    EXPECT_LT(split.unallocated, 6.5 + 2.5 + EPSILON);
+}
+
+TEST(SplitBudgetEqualRunway, MatchesSingleFleetRunway) {
+    // TC1: One project gets the whole pool and calculateFundsDurationMultipleGpus's runway
+    std::vector<std::vector<GpuModel>> projects = {{GpuModel("Test1", 1.0, 0.5, 5)}};
+    for (double funds : {0.0, 0.01, 122.5, 245.0, 1000.0, 10000.0}) {
+        BudgetSplit split = splitBudgetEqualRunway(funds, projects);
+        EXPECT_NEAR(calculateFundsDurationMultipleGpus(funds, projects[0]), split.runwayHours[0], EPSILON)
+            << "funds " << funds;
+    }
+
+    // TC2: A project that costs nothing takes no funds and runs indefinitely
+    projects.push_back({GpuModel("Free", 0.0, 0.0, 1)});
+    BudgetSplit split = splitBudgetEqualRunway(1000.0, projects);
+    EXPECT_NEAR(-1.0, split.runwayHours[1], EPSILON);
+    EXPECT_NEAR(0.0, split.funds[1], EPSILON);
+}
+
+// 2. Targets and weights
+TEST(SplitBudgetForTargets, TargetsAndWeights) {
+    std::vector<std::vector<GpuModel>> projects = {{GpuModel("Test1", 1.0, 0.0, 1)},
+                                                   {GpuModel("Test2", 1.0, 0.0, 1)},
+                                                   {GpuModel("Test3", 1.0, 0.0, 1)}};
+
+    // TC1: Project 0 caps at 10 hours; project 2 gets twice project 1's runway
+    std::vector<RunwayTarget> targets = {{10.0, 1.0}, {-1, 1.0}, {-1, 2.0}};
+    BudgetSplit split = splitBudgetForTargets(100.0, projects, targets);
+    EXPECT_NEAR(10.0, split.runwayHours[0], EPSILON);
+    EXPECT_NEAR(30.0, split.runwayHours[1], EPSILON);
+    EXPECT_NEAR(60.0, split.runwayHours[2], EPSILON);
+    EXPECT_NEAR(0.0, split.unallocated, EPSILON);
+
+    // TC2: Every target met leaves the rest unallocated
+    targets = {{10.0, 1.0}, {20.0, 1.0}, {5.0, 3.0}};
+    split = splitBudgetForTargets(100.0, projects, targets);
+    EXPECT_NEAR(20.0, split.runwayHours[1], EPSILON);
+    EXPECT_NEAR(65.0, split.unallocated, EPSILON);
+
+    // TC3: Targets out of reach are filled by level
+    split = splitBudgetForTargets(12.0, projects, targets);
+    EXPECT_NEAR(3.5, split.runwayHours[0], EPSILON);
+    EXPECT_NEAR(3.5, split.runwayHours[1], EPSILON);
+    EXPECT_NEAR(5.0, split.runwayHours[2], EPSILON);
+}
+
+TEST(SplitBudgetForTargets, ManyProjects) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> rate(0.1, 5.0);
+    std::uniform_real_distribution<double> target(10.0, 2000.0);
+    std::vector<std::vector<GpuModel>> projects;
+    std::vector<RunwayTarget> targets;
+    for (int i = 0; i < 5000; i++) {
+        projects.push_back({GpuModel("Model", rate(rng), rate(rng), 1 + i % 3)});
+        targets.push_back(RunwayTarget{i % 4 == 0 ? -1 : target(rng), 1.0 + i % 5});
+    }
+
+    BudgetSplit split = splitBudgetForTargets(2.0e6, projects, targets);
+
+    // TC1: Shares add up to the pool and each share buys its runway
+    double allocated = 0.0;
+    for (std::size_t i = 0; i < projects.size(); i++) {
+        allocated += split.funds[i];
+        if (i % 97 == 0) {
+            EXPECT_NEAR(split.runwayHours[i], calculateFundsDurationMultipleGpus(split.funds[i], projects[i]), EPSILON);
+        }
+    }
+    EXPECT_LE(allocated, 2.0e6 + EPSILON);
+    EXPECT_NEAR(2.0e6, allocated + split.unallocated, EPSILON);
+}
+
+TEST(SplitBudgetForTargets, InputValidation) {
+    std::vector<std::vector<GpuModel>> projects = {{GpuModel("Test1", 1.0, 0.5, 1)}};
+
+    // TC1: Negative funds, no projects, mismatched targets
+    EXPECT_THROW(splitBudgetEqualRunway(-1.0, projects), std::invalid_argument);
+    EXPECT_THROW(splitBudgetEqualRunway(1.0, {}), std::invalid_argument);
+    EXPECT_THROW(splitBudgetForTargets(1.0, projects, {}), std::invalid_argument);
+
+    // TC2: Non-positive weight, empty or invalid fleet
+    EXPECT_THROW(splitBudgetForTargets(1.0, projects, {RunwayTarget{-1, 0.0}}), std::invalid_argument);
+    projects.push_back({});
+    EXPECT_THROW(splitBudgetEqualRunway(1.0, projects), std::invalid_argument);
+    projects.back().push_back(GpuModel("Test2", 1.0, 0.5, 0));
+    EXPECT_THROW(splitBudgetEqualRunway(1.0, projects), std::invalid_argument);
+}
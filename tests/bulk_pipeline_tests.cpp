@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../src/bulk_pipeline.h"
+#include "../src/fleet_csv.h"
+#include "../src/spsc_ring.h"
+
+const double EPSILON = 0.001;
+
+// 1. Fleet CSV rows
+TEST(ParseFleetCsvRow, DecisionTable) {
+    GpuModel gpu;
+    std::string error;
+
+    // TC1: Valid row with spaces and CRLF ending
+    EXPECT_TRUE(parseFleetCsvRow(" A100 , 1.5, 0.25 ,4\r", gpu, error));
+    EXPECT_EQ("A100", gpu.getName());
+    EXPECT_NEAR(1.5, gpu.getHourlyRate(), EPSILON);
+    EXPECT_NEAR(0.25, gpu.getDailyStorageCost(), EPSILON);
+    EXPECT_EQ(4, gpu.getNumInstances());
+
+    // TC2: Wrong field count
+    EXPECT_FALSE(parseFleetCsvRow("A100,1.5,0.25", gpu, error));
+    EXPECT_FALSE(parseFleetCsvRow("A100,1.5,0.25,4,9", gpu, error));
+
+    // TC3: Malformed numbers
+    EXPECT_FALSE(parseFleetCsvRow("A100,abc,0.25,4", gpu, error));
+    EXPECT_EQ("Invalid hourly rate", error);
+    EXPECT_FALSE(parseFleetCsvRow("A100,1.5,0.25,4.5", gpu, error));
+    EXPECT_EQ("Invalid instance count", error);
+    EXPECT_FALSE(parseFleetCsvRow("A100,nan,0.25,4", gpu, error));
+
+    // TC4: Calculator validation rules
+    EXPECT_FALSE(parseFleetCsvRow("A100,-1,0.25,4", gpu, error));
+    EXPECT_EQ("GPU hourly rate can't be negative", error);
+    EXPECT_FALSE(parseFleetCsvRow("A100,1,-0.25,4", gpu, error));
+    EXPECT_EQ("GPU daily storage cost can't be negative", error);
+    EXPECT_FALSE(parseFleetCsvRow("A100,1,0.25,0", gpu, error));
+    EXPECT_EQ("GPU instance count must be positive", error);
+    EXPECT_FALSE(parseFleetCsvRow(",1,0.25,1", gpu, error));
+}
+
+// 2. SpscRing
+TEST(SpscRing, DeliversInOrderUnderBackpressure) {
+    SpscRing<int> ring(4);
+
+    // TC1: Full ring rejects tryPush
+    int value = 0;
+    for (int i = 0; i < 7; i++) {
+        value = i;
+        EXPECT_TRUE(ring.tryPush(value));
+    }
+    value = 7;
+    EXPECT_FALSE(ring.tryPush(value));
+    for (int i = 0; i < 7; i++) {
+        EXPECT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(ring.tryPop(value));
+
+    // TC2: Producer thread blocks on the small ring and every value arrives in order
+    std::thread producer([&]() {
+        for (int i = 0; i < 100000; i++) {
+            ring.push(i);
+        }
+        ring.close();
+    });
+    int expected = 0;
+    while (ring.pop(value)) {
+        ASSERT_EQ(expected, value);
+        expected++;
+    }
+    producer.join();
+    EXPECT_EQ(100000, expected);
+
+    // TC3: Zero capacity
+    EXPECT_THROW(SpscRing<int>(0), std::invalid_argument);
+}
+
+// 3. runBulkPipeline
+TEST(RunBulkPipeline, PricesEveryRowInOrder) {
+    std::stringstream input;
+    input << "name,hourlyRate,dailyStorageCost,numInstances\n"
+          << "A100,1.0,0.5,5\n"
+          << "\n"
+          << "# comment\n"
+          << "H100,-2.0,0.5,1\n";
+    for (int i = 0; i < 1000; i++) {
+        input << "GPU" << i << ",2.0,1.0,2\n";
+    }
+
+    std::stringstream output, errors;
+    PipelineConfig config;
+    config.runningHours = 50;
+    config.queueDepth = 2;
+    config.batchSize = 7;
+    PipelineStats stats = runBulkPipeline(input, output, errors, config);
+
+    // TC1: First priced row matches calculateTotalCost
+    std::string line;
+    std::getline(output, line);
+    EXPECT_EQ("A100,5,257.50", line);
+
+    // TC2: Invalid row reported with its line number
+    EXPECT_EQ("line 5: GPU hourly rate can't be negative\n", errors.str());
+    EXPECT_EQ(1u, stats.errorRows);
+
+    // TC3: Remaining rows appear in input order
+    for (int i = 0; i < 1000; i++) {
+        std::getline(output, line);
+        ASSERT_EQ("GPU" + std::to_string(i) + ",2,206.00", line);
+    }
+    EXPECT_FALSE(std::getline(output, line));
+
+    // TC4: Every stage saw every row
+    EXPECT_EQ(1002u, stats.parse.items);
+    EXPECT_EQ(1002u, stats.price.items);
+    EXPECT_EQ(1002u, stats.format.items);
+    EXPECT_EQ(stats.parse.batches, stats.format.batches);
+}
+
+TEST(RunBulkPipeline, InputValidation) {
+    std::stringstream input, output, errors;
+    PipelineConfig config;
+
+    // TC1: Negative hours, zero queue depth, zero batch size
+    config.runningHours = -1;
+    EXPECT_THROW(runBulkPipeline(input, output, errors, config), std::invalid_argument);
+    config.runningHours = 1;
+    config.queueDepth = 0;
+    EXPECT_THROW(runBulkPipeline(input, output, errors, config), std::invalid_argument);
+    config.queueDepth = 1;
+    config.batchSize = 0;
+    EXPECT_THROW(runBulkPipeline(input, output, errors, config), std::invalid_argument);
+
+    // TC2: Empty input
+    config.batchSize = 1;
+    PipelineStats stats = runBulkPipeline(input, output, errors, config);
+    EXPECT_EQ(0u, stats.parse.items);
+    EXPECT_EQ("", output.str());
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../src/burn_rate_estimator.h"
+#include "../src/funds_calculator.h"
+
+const double EPSILON = 0.001;
+
+// 1. Rate estimation
+TEST(BurnRateEstimator, SteadySpend) {
+    BurnRateEstimator estimator(24.0, 1.0);
+
+    // TC1: No closed bucket yet
+    estimator.observe(0.5, 10.0);
+    EXPECT_FALSE(estimator.hasHistory());
+
+    // TC2: $10 every hour settles at $10/hour with no spread
+    for (int hour = 1; hour < 100; hour++) {
+        estimator.observe(hour + 0.5, 10.0);
+    }
+    EXPECT_TRUE(estimator.hasHistory());
+    EXPECT_EQ(99u, estimator.getSampleCount());
+    EXPECT_NEAR(10.0, estimator.getEwmaRate(), EPSILON);
+    EXPECT_NEAR(0.0, estimator.getRateStdDev(), EPSILON);
+    EXPECT_NEAR(10.0, estimator.getQuantileRate(0.5), EPSILON);
+
+    // TC3: Several events in one bucket add up
+    BurnRateEstimator split(24.0, 1.0);
+    split.observe(0.1, 4.0);
+    split.observe(0.2, 6.0);
+    split.advanceTo(1.0);
+    EXPECT_NEAR(10.0, split.getEwmaRate(), EPSILON);
+}
+
+TEST(BurnRateEstimator, IdleTimeDecaysRate) {
+    BurnRateEstimator estimator(1.0, 1.0);
+    estimator.observe(0.0, 8.0);
+    estimator.advanceTo(1.0);
+    EXPECT_NEAR(8.0, estimator.getEwmaRate(), EPSILON);
+
+    // TC1: One idle bucket at a one-hour half-life halves the average
+    estimator.advanceTo(2.0);
+    EXPECT_NEAR(4.0, estimator.getEwmaRate(), EPSILON);
+
+    // TC2: A long idle gap (folded in closed form) matches replaying it bucket by bucket
+    BurnRateEstimator replayed(1.0, 1.0);
+    replayed.observe(0.0, 8.0);
+    for (int hour = 1; hour <= 200; hour++) {
+        replayed.advanceTo(hour);
+    }
+    BurnRateEstimator folded(1.0, 1.0);
+    folded.observe(0.0, 8.0);
+    folded.advanceTo(200.0);
+    EXPECT_EQ(replayed.getSampleCount(), folded.getSampleCount());
+    EXPECT_NEAR(replayed.getEwmaRate(), folded.getEwmaRate(), 1e-12);
+    EXPECT_NEAR(replayed.getRateStdDev(), folded.getRateStdDev(), 1e-12);
+    EXPECT_NEAR(0.0, folded.getQuantileRate(0.9), EPSILON);
+}
+
+TEST(BurnRateEstimator, QuantilesUseRecentWindow) {
+    BurnRateEstimator estimator(24.0, 1.0);
+
+    // TC1: Rates 1..64 over the window
+    for (int hour = 0; hour < 64; hour++) {
+        estimator.observe(hour, hour + 1.0);
+    }
+    estimator.advanceTo(64.0);
+    EXPECT_NEAR(1.0, estimator.getQuantileRate(0.0), EPSILON);
+    EXPECT_NEAR(64.0, estimator.getQuantileRate(1.0), EPSILON);
+    EXPECT_NEAR(33.0, estimator.getQuantileRate(0.5), EPSILON);
+
+    // TC2: Invalid inputs
+    EXPECT_THROW(estimator.getQuantileRate(1.5), std::invalid_argument);
+    EXPECT_THROW(estimator.observe(70.0, -1.0), std::invalid_argument);
+    EXPECT_THROW(BurnRateEstimator(0.0, 1.0), std::invalid_argument);
+
+    // TC3: Non-finite timestamps and charges are rejected and leave the estimator unchanged
+    double rate = estimator.getEwmaRate();
+    EXPECT_THROW(estimator.observe(std::nan(""), 1.0), std::invalid_argument);
+    EXPECT_THROW(estimator.observe(INFINITY, 1.0), std::invalid_argument);
+    EXPECT_THROW(estimator.observe(70.0, std::nan("")), std::invalid_argument);
+    EXPECT_THROW(estimator.observe(70.0, INFINITY), std::invalid_argument);
+    EXPECT_THROW(estimator.advanceTo(std::nan("")), std::invalid_argument);
+    EXPECT_EQ(rate, estimator.getEwmaRate());
+
+    // TC4: A huge but finite idle gap decays the rate to zero without overflowing the count
+    estimator.advanceTo(1e300);
+    EXPECT_NEAR(0.0, estimator.getEwmaRate(), EPSILON);
+    EXPECT_GT(estimator.getSampleCount(), 64u);
+}
+
+// 2. Runway forecasts
+TEST(BurnRateEstimator, Forecast) {
+    BurnRateEstimator estimator;
+
+    // TC1: No history falls back to calculateFundsDuration
+    RunwayForecast nominal = estimator.forecast(1000.0, 1.0, 5, 0.5);
+    EXPECT_FALSE(nominal.fromObservedSpend);
+    EXPECT_NEAR(calculateFundsDuration(1000.0, 1.0, 5, 0.5), nominal.expectedHours, EPSILON);
+    EXPECT_NEAR(nominal.expectedHours, nominal.lowHours, EPSILON);
+
+    // TC2: Observed spend of $5/hour with a noisy band
+    for (int hour = 0; hour < 240; hour++) {
+        estimator.observe(hour, hour % 2 == 0 ? 4.0 : 6.0);
+    }
+    estimator.advanceTo(240.0);
+    RunwayForecast observed = estimator.forecast(1000.0, 1.0, 5, 0.5);
+    EXPECT_TRUE(observed.fromObservedSpend);
+    EXPECT_NEAR(200.0, observed.expectedHours, 10.0);
+    EXPECT_NEAR(1000.0 / 6.0, observed.lowHours, EPSILON);
+    EXPECT_NEAR(1000.0 / 4.0, observed.highHours, EPSILON);
+
+    // TC3: Exhausted funds
+    EXPECT_NEAR(0.0, estimator.forecast(0.0, 1.0, 5, 0.5).expectedHours, EPSILON);
+}
+
+// 3. Many wallets
+TEST(WalletBurnTracker, KeepsWalletsApart) {
+    WalletBurnTracker tracker(3, 24.0, 1.0);
+    std::vector<std::uint32_t> wallets;
+    std::vector<double> times, amounts;
+    for (int hour = 0; hour < 10; hour++) {
+        for (std::uint32_t wallet = 0; wallet < 3; wallet++) {
+            wallets.push_back(wallet);
+            times.push_back(hour);
+            amounts.push_back(wallet + 1.0);
+        }
+    }
+    tracker.observeBatch(wallets.data(), times.data(), amounts.data(), wallets.size());
+
+    // TC1: Each wallet sees only its own charges
+    EXPECT_EQ(3u, tracker.size());
+    EXPECT_NEAR(1.0, tracker.getWallet(0).getEwmaRate(), EPSILON);
+    EXPECT_NEAR(3.0, tracker.getWallet(2).getEwmaRate(), EPSILON);
+
+    // TC2: Unknown wallet id
+    EXPECT_THROW(tracker.observe(3, 0.0, 1.0), std::out_of_range);
+}
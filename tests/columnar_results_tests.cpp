@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/columnar_results.h"
+#include "../src/funds_calculator.h"
+
+static std::size_t fileSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return (std::size_t)(file.tellg());
+}
+
+// 1. Write and read back
+TEST(ColumnarResults, RoundTrip) {
+    std::string path = testing::TempDir() + "results_roundtrip.vcol";
+    const char* models[] = {"A100", "V100", "H100"};
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> instances(1, 16);
+
+    std::vector<std::int64_t> names, counts, hours, cents;
+    std::size_t csvBytes = 0;
+    {
+        ColumnarResultWriter writer(path, 1000);
+        for (int i = 0; i < 25000; i++) {
+            int model = i % 3;
+            int count = instances(rng);
+            int runningHours = 1 + i / 3;
+            double cost = calculateTotalCost(1.0 + model, count, runningHours, 0.5);
+            writer.append(models[model], count, runningHours, cost);
+
+            names.push_back(model);
+            counts.push_back(count);
+            hours.push_back(runningHours);
+            cents.push_back(std::llround(cost * 100.0));
+            csvBytes += std::string(models[model]).size() + std::to_string(count).size()
+                        + std::to_string(runningHours).size() + std::to_string(cost).size() + 4;
+        }
+        writer.close();
+        EXPECT_EQ(25000u, writer.getRowCount());
+    }
+
+    ColumnarResultReader reader(path);
+
+    // TC1: Shape and dictionary
+    EXPECT_EQ(25000u, reader.getRowCount());
+    EXPECT_EQ(25u, reader.getBlockCount());
+    EXPECT_EQ(1000u, reader.getBlockRowCount(24));
+    ASSERT_EQ(3u, reader.getModelNames().size());
+    EXPECT_EQ("V100", reader.getModelNames()[1]);
+
+    // TC2: Every column decodes to what was written
+    EXPECT_EQ(names, reader.readColumn(ResultColumn::ModelName));
+    EXPECT_EQ(counts, reader.readColumn(ResultColumn::NumInstances));
+    EXPECT_EQ(hours, reader.readColumn(ResultColumn::RunningHours));
+    EXPECT_EQ(cents, reader.readColumn(ResultColumn::TotalCostCents));
+
+    // TC3: A single block of a single column
+    std::vector<std::int64_t> block;
+    reader.readBlock(ResultColumn::TotalCostCents, 7, block);
+    EXPECT_EQ(std::vector<std::int64_t>(cents.begin() + 7000, cents.begin() + 8000), block);
+    EXPECT_THROW(reader.readBlock(ResultColumn::TotalCostCents, 25, block), std::out_of_range);
+
+    // TC4: Much smaller than the same rows as CSV
+    EXPECT_LT(fileSize(path) * 3, csvBytes);
+    std::remove(path.c_str());
+}
+
+TEST(ColumnarResults, EmptyAndUnclosedFiles) {
+    std::string path = testing::TempDir() + "results_empty.vcol";
+
+    // TC1: A file with no rows is valid
+    {
+        ColumnarResultWriter writer(path);
+        writer.close();
+    }
+    ColumnarResultReader reader(path);
+    EXPECT_EQ(0u, reader.getRowCount());
+    EXPECT_TRUE(reader.readColumn(ResultColumn::TotalCostCents).empty());
+    std::remove(path.c_str());
+
+    // TC2: A writer destroyed without close() leaves nothing behind
+    std::string abandoned = testing::TempDir() + "results_abandoned.vcol";
+    {
+        ColumnarResultWriter writer(abandoned);
+        writer.append("A100", 1, 1, 1.0);
+    }
+    EXPECT_FALSE(std::ifstream(abandoned).good());
+    EXPECT_FALSE(std::ifstream(abandoned + ".tmp").good());
+}
+
+TEST(ColumnarResults, RejectsCorruptFiles) {
+    std::string path = testing::TempDir() + "results_corrupt.vcol";
+    {
+        ColumnarResultWriter writer(path, 4);
+        for (int i = 0; i < 10; i++) {
+            writer.append("A100", 1, i, i * 1.5);
+        }
+        writer.close();
+    }
+
+    // TC1: Missing file and wrong magic
+    EXPECT_THROW(ColumnarResultReader(path + ".missing"), std::runtime_error);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(0);
+        file.write("X", 1);
+    }
+    EXPECT_THROW(ColumnarResultReader reader(path), std::runtime_error);
+
+    // TC2: Truncated file loses its footer
+    std::size_t size = fileSize(path);
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), (std::streamsize)(size - 8));
+    }
+    EXPECT_THROW(ColumnarResultReader reader(path), std::runtime_error);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/cost_curve.h"
+#include "../src/funds_calculator.h"
+
+const double EPSILON = 0.001;
+
+// 1. Hourly series
+TEST(CostCurve, MatchesMultipleGpus) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2), GpuModel("Test2", 3.0, 1.5, 3)};
+    CostCurve curve(gpuModels);
+    EXPECT_NEAR(13.0, curve.getHourlyRate(), EPSILON);
+    EXPECT_NEAR(6.5, curve.getDailyStorageCost(), EPSILON);
+
+    int horizon = 24 * 7 + 3;
+    std::vector<int> hours(CostCurve::pointCount(horizon, 1));
+    std::vector<double> cost(hours.size()), remaining(hours.size());
+    ASSERT_EQ((std::size_t)(horizon + 1), curve.fill(1000.0, horizon, 1, hours.data(), cost.data(), remaining.data()));
+
+    // TC1: Every hour agrees with the fleet calculator, including the storage jumps at hours 1, 25, ...
+    for (int h = 0; h <= horizon; h++) {
+        EXPECT_EQ(h, hours[h]);
+        EXPECT_NEAR(calculateTotalCostMultipleGpus(gpuModels, h), cost[h], EPSILON) << "hour " << h;
+        EXPECT_NEAR(1000.0 - cost[h], remaining[h], EPSILON);
+    }
+    EXPECT_NEAR(6.5, cost[1] - cost[0] - 13.0, EPSILON);
+    EXPECT_NEAR(0.0, cost[24] - cost[23] - 13.0, EPSILON);
+}
+
+// 2. Decimated series
+TEST(CostCurve, Decimation) {
+    CostCurve curve({GpuModel("Test1", 1.0, 0.5, 5)});
+
+    // TC1: Horizon not a multiple of the stride still ends on the horizon
+    EXPECT_EQ(5u, CostCurve::pointCount(100, 30));
+    EXPECT_EQ(4u, CostCurve::pointCount(90, 30));
+    EXPECT_EQ(1u, CostCurve::pointCount(0, 30));
+    int hours[5];
+    double cost[5];
+    curve.fill(0.0, 100, 30, hours, cost, nullptr);
+    EXPECT_EQ(60, hours[2]);
+    EXPECT_EQ(100, hours[4]);
+    EXPECT_NEAR(calculateTotalCost(1.0, 5, 100, 0.5), cost[4], EPSILON);
+
+    // TC2: A ten-year horizon at daily resolution
+    int horizon = 24 * 3650;
+    std::vector<double> longCost(CostCurve::pointCount(horizon, 24));
+    curve.fill(0.0, horizon, 24, nullptr, longCost.data(), nullptr);
+    EXPECT_NEAR(calculateTotalCost(1.0, 5, horizon, 0.5), longCost.back(), EPSILON);
+}
+
+TEST(CostCurve, InputValidation) {
+    // TC1: Empty or invalid fleet
+    EXPECT_THROW(CostCurve(std::vector<GpuModel>()), std::invalid_argument);
+    EXPECT_THROW(CostCurve({GpuModel("Test1", -1.0, 0.5, 1)}), std::invalid_argument);
+
+    // TC2: Negative horizon or non-positive stride
+    CostCurve curve({GpuModel("Test1", 1.0, 0.5, 1)});
+    EXPECT_THROW(CostCurve::pointCount(-1, 1), std::invalid_argument);
+    EXPECT_THROW(curve.fill(0.0, 10, 0, nullptr, nullptr, nullptr), std::invalid_argument);
+    EXPECT_THROW(curve.costAt(-1), std::invalid_argument);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/csv_ingest.h"
+#include "../src/fleet_csv.h"
+
+const double EPSILON = 0.001;
+
+namespace {
+
+// A catalog with long and short names, CRLF endings, comments, blank lines and bad rows
+std::string makeCatalog(std::size_t rows) {
+    const char* names[] = {"A100", "H100 SXM5 80GB with a rather long marketing name", "RTX 4090", "T4"};
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> pick(0, 19);
+    std::ostringstream csv;
+    csv << "name,hourlyRate,dailyStorageCost,numInstances\n";
+    for (std::size_t i = 0; i < rows; i++) {
+        int kind = pick(rng);
+        const char* name = names[i % 4];
+        if (kind == 0) {
+            csv << name << ",-1.5,0.5,2\n";
+        } else if (kind == 1) {
+            csv << name << ",1.5,0.5\n";
+        } else if (kind == 2) {
+            csv << name << ",1.5,0.5,0,extra\n";
+        } else if (kind == 3) {
+            csv << "# comment, with, commas\n\n";
+        } else if (kind == 4) {
+            csv << " " << name << " , 2.25 , 0.75 , 3 \r\n";
+        } else {
+            csv << name << "," << (i % 7) * 0.5 << "," << (i % 3) * 0.25 << "," << 1 + i % 5 << "\n";
+        }
+    }
+    csv << "T4,0.35,0.1,1";  // no trailing newline
+    return csv.str();
+}
+
+// What reading the catalog line by line with parseFleetCsvRow gives
+void parseSequentially(const std::string& text, std::vector<GpuModel>& rows, std::vector<CsvRowError>& errors) {
+    std::istringstream in(text);
+    std::string line;
+    std::size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#' || line == "\r" || (lineNumber == 1 && line.rfind("name,", 0) == 0)) {
+            continue;
+        }
+        GpuModel gpu;
+        std::string error;
+        if (parseFleetCsvRow(line, gpu, error)) {
+            rows.push_back(gpu);
+        } else {
+            errors.push_back(CsvRowError{lineNumber, error});
+        }
+    }
+}
+
+} // namespace
+
+// 1. Agreement with the row parser
+TEST(IngestFleetCsv, MatchesRowParser) {
+    std::string text = makeCatalog(5000);
+    std::vector<GpuModel> expectedRows;
+    std::vector<CsvRowError> expectedErrors;
+    parseSequentially(text, expectedRows, expectedErrors);
+
+    // TC1-TC3: One chunk, chunks smaller than a line, many threads
+    for (std::size_t chunkBytes : {std::size_t(1) << 24, std::size_t(7), std::size_t(4096)}) {
+        CsvIngestConfig config;
+        config.chunkBytes = chunkBytes;
+        config.threadCount = 4;
+        config.maxErrors = 100000;
+        CsvIngestResult result = ingestFleetCsvBuffer(text.data(), text.size(), config);
+
+        std::vector<GpuModel> rows = result.fleet.toGpuModels();
+        ASSERT_EQ(expectedRows.size(), rows.size()) << "chunk " << chunkBytes;
+        for (std::size_t i = 0; i < rows.size(); i++) {
+            ASSERT_EQ(expectedRows[i].getName(), rows[i].getName()) << "row " << i;
+            ASSERT_NEAR(expectedRows[i].getHourlyRate(), rows[i].getHourlyRate(), EPSILON);
+            ASSERT_NEAR(expectedRows[i].getDailyStorageCost(), rows[i].getDailyStorageCost(), EPSILON);
+            ASSERT_EQ(expectedRows[i].getNumInstances(), rows[i].getNumInstances());
+        }
+        ASSERT_EQ(expectedErrors.size(), result.errors.size());
+        EXPECT_EQ(expectedErrors.size(), result.errorRows);
+        for (std::size_t i = 0; i < expectedErrors.size(); i++) {
+            ASSERT_EQ(expectedErrors[i].lineNumber, result.errors[i].lineNumber);
+            ASSERT_EQ(expectedErrors[i].message, result.errors[i].message);
+        }
+        EXPECT_EQ(4u, result.fleet.modelNames.size());
+        EXPECT_EQ(expectedRows[0].getName(), result.fleet.modelNames[0]);
+    }
+}
+
+TEST(IngestFleetCsv, ErrorMessages) {
+    std::string text = "A100,-1,0.5,1\nA100,1,-0.5,1\nA100,1,0.5,0\nA100,1,0.5\nA100,x,0.5,1\n";
+    CsvIngestResult result = ingestFleetCsvBuffer(text.data(), text.size());
+
+    // TC1: The calculator's validation messages, one per line
+    ASSERT_EQ(5u, result.errors.size());
+    EXPECT_EQ("GPU hourly rate can't be negative", result.errors[0].message);
+    EXPECT_EQ("GPU daily storage cost can't be negative", result.errors[1].message);
+    EXPECT_EQ("GPU instance count must be positive", result.errors[2].message);
+    EXPECT_EQ("Expected 4 comma-separated fields", result.errors[3].message);
+    EXPECT_EQ("Invalid hourly rate", result.errors[4].message);
+    EXPECT_EQ(5u, result.errors[4].lineNumber);
+    EXPECT_EQ(0u, result.fleet.size());
+
+    // TC2: Only maxErrors are kept, all are counted
+    CsvIngestConfig config;
+    config.maxErrors = 2;
+    config.chunkBytes = 10;
+    result = ingestFleetCsvBuffer(text.data(), text.size(), config);
+    EXPECT_EQ(2u, result.errors.size());
+    EXPECT_EQ(5u, result.errorRows);
+    EXPECT_EQ(2u, result.errors[1].lineNumber);
+}
+
+// 2. Mapped files
+TEST(IngestFleetCsv, File) {
+    std::string path = testing::TempDir() + "csv_ingest_test.csv";
+    std::string text = makeCatalog(200);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+
+    // TC1: Same rows as the in-memory path
+    CsvIngestResult fromFile = ingestFleetCsv(path);
+    CsvIngestResult fromBuffer = ingestFleetCsvBuffer(text.data(), text.size());
+    EXPECT_EQ(fromBuffer.fleet.size(), fromFile.fleet.size());
+    EXPECT_EQ(fromBuffer.errorRows, fromFile.errorRows);
+    EXPECT_EQ(fromBuffer.lineCount, fromFile.lineCount);
+
+    // TC2: Empty and missing files
+    { std::ofstream out(path, std::ios::trunc); }
+    EXPECT_EQ(0u, ingestFleetCsv(path).fleet.size());
+    std::remove(path.c_str());
+    EXPECT_THROW(ingestFleetCsv(path), std::runtime_error);
+}
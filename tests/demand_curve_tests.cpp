@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/demand_curve.h"
+#include "../src/funds_calculator.h"
+
+const double EPSILON = 0.001;
+
+// 1. Flat curves agree with the fixed-fleet calculators
+TEST(PriceDemandCurve, FlatCurveMatchesFixedFleet) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2), GpuModel("Test2", 3.0, 1.5, 3)};
+    std::vector<std::vector<int>> curves = {std::vector<int>(50, 2), std::vector<int>(50, 3)};
+
+    // TC1: Total cost over 50 hours
+    DemandCurveCost cost = priceDemandCurve(gpuModels, curves, 1e9);
+    EXPECT_NEAR(calculateTotalCostMultipleGpus(gpuModels, 50), cost.totalCost, EPSILON);
+    EXPECT_NEAR(cost.totalCost, cost.cumulativeCost.back(), EPSILON);
+    EXPECT_NEAR(-1.0, cost.fundsExhaustedHour, EPSILON);
+
+    // TC2: Funds run out where calculateFundsDurationMultipleGpus says
+    curves = {std::vector<int>(2000, 2), std::vector<int>(2000, 3)};
+    cost = priceDemandCurve(gpuModels, curves, 1000.0);
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(1000.0, gpuModels), cost.fundsExhaustedHour, EPSILON);
+
+    // TC3: No funds
+    EXPECT_NEAR(0.0, priceDemandCurve(gpuModels, curves, 0.0).fundsExhaustedHour, EPSILON);
+}
+
+// 2. Autoscaling
+TEST(PriceDemandCurve, StorageBilledOnDailyPeak) {
+    std::vector<GpuModel> gpuModels = {GpuModel("A100", 1.0, 10.0, 1)};
+
+    // Day 0: 1 instance with a 2-hour spike to 4; day 1: idle; day 2 (6 hours): 2 instances
+    std::vector<int> curve(54, 0);
+    for (int h = 0; h < 24; h++) {
+        curve[h] = (h == 5 || h == 6) ? 4 : 1;
+    }
+    for (int h = 48; h < 54; h++) {
+        curve[h] = 2;
+    }
+
+    // TC1: Runtime 22 + 8 + 12 = 42, storage 4 * 10 + 0 + 2 * 10 = 60
+    DemandCurveCost cost = priceDemandCurve(gpuModels, curve.data(), curve.size(), 1e9);
+    EXPECT_NEAR(102.0, cost.totalCost, EPSILON);
+
+    // TC2: Storage is charged at the start of each day
+    EXPECT_NEAR(41.0, cost.cumulativeCost[0], EPSILON);
+    EXPECT_NEAR(70.0, cost.cumulativeCost[47], EPSILON);
+    EXPECT_NEAR(92.0, cost.cumulativeCost[48], EPSILON);
+
+    // TC3: Running out during the spike
+    cost = priceDemandCurve(gpuModels, curve.data(), curve.size(), 48.0);
+    EXPECT_NEAR(5.75, cost.fundsExhaustedHour, EPSILON);
+
+    // TC4: Running out on a day's storage charge
+    cost = priceDemandCurve(gpuModels, curve.data(), curve.size(), 75.0);
+    EXPECT_NEAR(48.0, cost.fundsExhaustedHour, EPSILON);
+}
+
+TEST(PriceDemandCurve, InputValidation) {
+    std::vector<GpuModel> gpuModels = {GpuModel("A100", 1.0, 10.0, 1)};
+
+    // TC1: Negative instance count in the curve
+    EXPECT_THROW(priceDemandCurve(gpuModels, {{1, -1}}, 10.0), std::invalid_argument);
+
+    // TC2: Curve count and lengths must line up
+    EXPECT_THROW(priceDemandCurve(gpuModels, {{1}, {1}}, 10.0), std::invalid_argument);
+    EXPECT_THROW(priceDemandCurve({GpuModel("A", 1.0, 1.0), GpuModel("B", 1.0, 1.0)}, {{1, 1}, {1}}, 10.0),
+                 std::invalid_argument);
+
+    // TC3: Negative funds and rates
+    EXPECT_THROW(priceDemandCurve(gpuModels, {{1}}, -1.0), std::invalid_argument);
+    EXPECT_THROW(priceDemandCurve({GpuModel("Bad", -1.0, 0.0)}, {{1}}, 10.0), std::invalid_argument);
+}
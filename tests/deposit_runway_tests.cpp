@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/deposit_runway.h"
+#include "../src/funds_calculator.h"
+
+const double EPSILON = 0.001;
+
+// 1. Scheduled deposits
+TEST(CalculateFundsDurationWithDeposits, NoDepositsMatchesScalar) {
+    // TC1: Same values as the scalar boundary tests
+    std::vector<double> funds = {1000.0, 0.0, 0.01, 10000.0, 122.5, 245.0, 1000.0};
+    std::vector<double> rates = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0};
+    for (std::size_t i = 0; i < funds.size(); i++) {
+        DepositRunway runway = calculateFundsDurationWithDeposits(funds[i], rates[i], 5, 0.5, {});
+        EXPECT_NEAR(calculateFundsDuration(funds[i], rates[i], 5, 0.5), runway.runwayHours, EPSILON) << "row " << i;
+    }
+
+    // TC2: A deposit at hour 0 is the same as more initial funds
+    EXPECT_NEAR(calculateFundsDuration(1500.0, 1.0, 5, 0.5),
+                calculateFundsDurationWithDeposits(1000.0, 1.0, 5, 0.5, {{0.0, 500.0}}).runwayHours, EPSILON);
+
+    // TC3: No ongoing cost
+    EXPECT_NEAR(-1.0, calculateFundsDurationWithDeposits(10.0, 0.0, 5, 0.0, {}).runwayHours, EPSILON);
+}
+
+TEST(CalculateFundsDurationWithDeposits, WeeklyDepositsForAYear) {
+    // Each week burns 168 of the 169 on hand, leaving 1 when the next grant arrives
+    std::vector<Deposit> deposits;
+    for (int week = 52; week >= 1; week--) {
+        deposits.push_back(Deposit{168.0 * week, 168.0});
+    }
+
+    DepositRunway runway = calculateFundsDurationWithDeposits(169.0, 1.0, 1, 0.0, deposits);
+
+    // TC1: Every deposit arrives in time; the last one runs 169 hours
+    EXPECT_NEAR(52 * 168.0 + 169.0, runway.runwayHours, EPSILON);
+    EXPECT_NEAR(52 * 168.0, runway.totalDeposited, EPSILON);
+
+    // TC2: A wallet that is already empty isn't restarted
+    runway = calculateFundsDurationWithDeposits(168.0, 1.0, 1, 0.0, deposits);
+    EXPECT_NEAR(168.0, runway.runwayHours, EPSILON);
+    EXPECT_NEAR(0.0, runway.totalDeposited, EPSILON);
+}
+
+TEST(CalculateFundsDurationWithDeposits, DepositAtDayBoundary) {
+    // TC1: 40 covers day 0 (10 storage + 24 hours) but not day 1's storage
+    EXPECT_NEAR(24.0, calculateFundsDurationWithDeposits(40.0, 1.0, 1, 10.0, {}).runwayHours, EPSILON);
+
+    // TC2: A deposit due at hour 24 arrives before that day's storage: 56 then lasts 36 more hours
+    EXPECT_NEAR(60.0, calculateFundsDurationWithDeposits(40.0, 1.0, 1, 10.0, {{24.0, 50.0}}).runwayHours, EPSILON);
+
+    // TC3: Mid-day deposit
+    EXPECT_NEAR(calculateFundsDuration(90.0, 1.0, 1, 10.0),
+                calculateFundsDurationWithDeposits(40.0, 1.0, 1, 10.0, {{12.0, 50.0}}).runwayHours, EPSILON);
+}
+
+// 2. Auto-recharge
+TEST(CalculateFundsDurationWithDeposits, AutoRecharge) {
+    AutoRecharge recharge;
+    recharge.floorBalance = 2.0;
+    recharge.amount = 5.0;
+    recharge.maxRecharges = 3;
+
+    // TC1: Recharges at hours 8, 13 and 18, then the last 7 runs out at hour 25
+    DepositRunway runway = calculateFundsDurationWithDeposits(10.0, 1.0, 1, 0.0, {}, recharge);
+    EXPECT_NEAR(25.0, runway.runwayHours, EPSILON);
+    EXPECT_EQ(3, runway.recharges);
+    EXPECT_NEAR(15.0, runway.totalDeposited, EPSILON);
+
+    // TC2: Same total as a fleet with the recharges paid up front
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2), GpuModel("Test2", 3.0, 1.5, 3)};
+    runway = calculateFundsDurationWithDepositsMultipleGpus(1000.0, gpuModels, {}, recharge);
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(1015.0, gpuModels), runway.runwayHours, EPSILON);
+
+    // TC3: Unlimited recharges never run out
+    recharge.maxRecharges = -1;
+    EXPECT_NEAR(-1.0, calculateFundsDurationWithDeposits(10.0, 1.0, 1, 0.0, {}, recharge).runwayHours, EPSILON);
+}
+
+TEST(CalculateFundsDurationWithDeposits, InputValidation) {
+    // TC1: Scalar rules
+    EXPECT_THROW(calculateFundsDurationWithDeposits(-1.0, 1.0, 1, 0.5, {}), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDurationWithDeposits(1.0, 1.0, 0, 0.5, {}), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDurationWithDepositsMultipleGpus(1.0, {}, {}), std::invalid_argument);
+
+    // TC2: Deposits and recharge rule
+    EXPECT_THROW(calculateFundsDurationWithDeposits(1.0, 1.0, 1, 0.5, {{-1.0, 1.0}}), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDurationWithDeposits(1.0, 1.0, 1, 0.5, {{1.0, -1.0}}), std::invalid_argument);
+    AutoRecharge recharge;
+    recharge.amount = -1.0;
+    EXPECT_THROW(calculateFundsDurationWithDeposits(1.0, 1.0, 1, 0.5, {}, recharge), std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../src/fleet_aggregation.h"
+#include "../src/funds_calculator.h"
+#include "../src/gpu_model.h"
+#include "../src/string_interner.h"
+
+const double EPSILON = 0.001;
+
+// 1. StringInterner
+TEST(StringInterner, AssignsDenseIds) {
+    StringInterner interner;
+
+    // TC1: New names get ids in first-appearance order
+    EXPECT_EQ(0u, interner.intern("A100"));
+    EXPECT_EQ(1u, interner.intern("H100"));
+
+    // TC2: Known names return their existing id
+    EXPECT_EQ(0u, interner.intern("A100"));
+    EXPECT_EQ(2u, interner.size());
+    EXPECT_EQ("H100", interner.nameOf(1));
+
+    // TC3: Lookup of unknown name
+    EXPECT_EQ(StringInterner::NOT_FOUND, interner.find("V100"));
+    EXPECT_THROW(interner.nameOf(5), std::out_of_range);
+
+    // TC4: Ids and names survive table growth
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ((std::uint32_t)(i + 2), interner.intern("GPU" + std::to_string(i)));
+    }
+    EXPECT_EQ(0u, interner.find("A100"));
+    EXPECT_EQ(501u, interner.find("GPU499"));
+    EXPECT_EQ("GPU999", interner.nameOf(1001));
+}
+
+// 2. aggregateFleetByModel
+TEST(AggregateFleetByModel, GroupsRowsByName) {
+    std::vector<GpuModel> gpuModels = {
+        GpuModel("A100", 2.0, 1.0, 2),
+        GpuModel("H100", 3.0, 1.5, 3),
+        GpuModel("A100", 1.0, 0.5, 1),
+    };
+
+    FleetAggregateReport report = aggregateFleetByModel(gpuModels, 50);
+
+    // TC1: One entry per distinct name, in first-appearance order
+    ASSERT_EQ(2u, report.models.size());
+    EXPECT_EQ("A100", report.models[0].name);
+    EXPECT_EQ("H100", report.models[1].name);
+
+    // TC2: Per-model sums
+    EXPECT_EQ(2u, report.models[0].rows);
+    EXPECT_EQ(3, report.models[0].instances);
+    EXPECT_NEAR(250.0, report.models[0].runtimeCost, EPSILON);
+    EXPECT_NEAR(7.5, report.models[0].storageCost, EPSILON);
+    EXPECT_NEAR(257.5, report.models[0].totalCost, EPSILON);
+
+    // TC3: Fleet totals agree with calculateTotalCostMultipleGpus
+    EXPECT_EQ(6, report.totalInstances);
+    EXPECT_NEAR(calculateTotalCostMultipleGpus(gpuModels, 50), report.totalCost, EPSILON);
+
+    // TC4: Burn shares sum to one
+    EXPECT_NEAR(1.0, report.models[0].burnShare + report.models[1].burnShare, EPSILON);
+    EXPECT_NEAR(5.0 + 2.5 / 24.0, report.models[0].hourlyBurn, EPSILON);
+}
+
+TEST(AggregateFleetByModel, DeterministicAcrossThreadCounts) {
+    std::vector<GpuModel> gpuModels;
+    for (int i = 0; i < 300000; i++) {
+        gpuModels.push_back(GpuModel("GPU" + std::to_string(i % 50), 0.01 * (i % 97), 0.003 * (i % 31), 1 + i % 4));
+    }
+
+    FleetAggregateReport serial = aggregateFleetByModel(gpuModels, 73, 1);
+    FleetAggregateReport parallel = aggregateFleetByModel(gpuModels, 73, 4);
+
+    // TC1: Same groups in the same order, bit-identical sums
+    ASSERT_EQ(50u, serial.models.size());
+    ASSERT_EQ(serial.models.size(), parallel.models.size());
+    for (std::size_t i = 0; i < serial.models.size(); i++) {
+        EXPECT_EQ(serial.models[i].name, parallel.models[i].name);
+        EXPECT_EQ(serial.models[i].instances, parallel.models[i].instances);
+        EXPECT_EQ(serial.models[i].totalCost, parallel.models[i].totalCost);
+        EXPECT_EQ(serial.models[i].burnShare, parallel.models[i].burnShare);
+    }
+    EXPECT_EQ(serial.totalCost, parallel.totalCost);
+}
+
+TEST(AggregateFleetByModel, InputValidation) {
+    std::vector<GpuModel> gpuModels;
+
+    // TC1: Empty fleet
+    EXPECT_THROW(aggregateFleetByModel(gpuModels, 10), std::invalid_argument);
+
+    // TC2: Negative running hours
+    gpuModels = {GpuModel("A100", 1.0, 0.5, 1)};
+    EXPECT_THROW(aggregateFleetByModel(gpuModels, -1), std::invalid_argument);
+
+    // TC3: Invalid rows
+    gpuModels = {GpuModel("A100", 1.0, -0.5, 1)};
+    EXPECT_THROW(aggregateFleetByModel(gpuModels, 10), std::invalid_argument);
+    gpuModels = {GpuModel("A100", 1.0, 0.5, 0)};
+    EXPECT_THROW(aggregateFleetByModel(gpuModels, 10), std::invalid_argument);
+
+    // TC3.1: Non-finite rows throw like calculateTotalCostMultipleGpus instead of giving NaN totals
+    gpuModels = {GpuModel("A100", 1.0, 0.5, 1), GpuModel("A100", std::nan(""), 0.5, 1)};
+    try {
+        aggregateFleetByModel(gpuModels, 10);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ("GPU hourly rate must be finite", e.what());
+    }
+
+    // TC4: Zero-cost fleet has zero burn shares
+    gpuModels = {GpuModel("Idle", 0.0, 0.0, 2)};
+    FleetAggregateReport report = aggregateFleetByModel(gpuModels, 10);
+    EXPECT_NEAR(0.0, report.models[0].burnShare, EPSILON);
+}
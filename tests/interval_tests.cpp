@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/interval.h"
+
+const double EPSILON = 0.001;
+
+// 1. Interval arithmetic
+TEST(Interval, DirectedRounding) {
+    // TC1: Exact operations stay exact
+    Interval sum = Interval(1.0, 2.0) + Interval(0.5);
+    EXPECT_EQ(1.5, sum.getLower());
+    EXPECT_EQ(2.5, sum.getUpper());
+    Interval product = Interval(-2.0, 3.0) * Interval(4.0, 5.0);
+    EXPECT_EQ(-10.0, product.getLower());
+    EXPECT_EQ(15.0, product.getUpper());
+
+    // TC2: Inexact results are widened to contain the real value
+    Interval third = Interval(1.0) / Interval(3.0);
+    EXPECT_LT(third.getLower(), third.getUpper());
+    EXPECT_TRUE(third.contains(1.0 / 3.0));
+    Interval tenth = Interval(0.1) + Interval(0.2);
+    EXPECT_TRUE(tenth.contains(0.1 + 0.2));
+    EXPECT_LT(tenth.getLower(), tenth.getUpper());
+
+    // TC3: ceil/min/max and invalid intervals
+    EXPECT_EQ(2.0, ceil(Interval(1.2, 3.5)).getLower());
+    EXPECT_EQ(4.0, max(Interval(1.0, 4.0), Interval(2.0, 3.0)).getUpper());
+    EXPECT_THROW(Interval(2.0, 1.0), std::invalid_argument);
+    EXPECT_THROW(Interval(1.0) / Interval(-1.0, 1.0), std::invalid_argument);
+}
+
+// 2. Bounded calculators
+TEST(IntervalCalculators, PointIntervalsMatchScalar) {
+    // TC1: Degenerate inputs bound the scalar result tightly
+    Interval cost = calculateTotalCost(Interval(1.0), 5, 100, Interval(0.5));
+    EXPECT_TRUE(cost.contains(calculateTotalCost(1.0, 5, 100, 0.5)));
+    EXPECT_NEAR(cost.getLower(), cost.getUpper(), EPSILON);
+
+    std::vector<double> funds = {1000.0, 0.01, 10000.0, 1000.0, 122.5, 245.0, 0.0};
+    std::vector<double> rates = {1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0};
+    for (std::size_t i = 0; i < funds.size(); i++) {
+        double expected = calculateFundsDuration(funds[i], rates[i], 5, 0.5);
+        Interval bounds = calculateFundsDuration(Interval(funds[i]), Interval(rates[i]), 5, Interval(0.5));
+        EXPECT_TRUE(bounds.contains(expected)) << "row " << i;
+        EXPECT_NEAR(bounds.getLower(), bounds.getUpper(), EPSILON) << "row " << i;
+    }
+
+    // TC2: No ongoing cost is unbounded
+    Interval forever = calculateFundsDuration(Interval(10.0), Interval(0.0), 1, Interval(0.0));
+    EXPECT_TRUE(std::isinf(forever.getUpper()));
+}
+
+TEST(IntervalCalculators, BoundsContainEverySample) {
+    Interval fundsRange(800.0, 1200.0);
+    Interval rateRange(0.8, 1.25);
+    Interval storageRange(0.0, 0.75);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto sample = [&](const Interval& range) {
+        return range.getLower() + unit(rng) * (range.getUpper() - range.getLower());
+    };
+
+    Interval cost = calculateTotalCost(rateRange, 3, 100, storageRange);
+    Interval runway = calculateFundsDuration(fundsRange, rateRange, 3, storageRange);
+    Interval remaining = calculateRemainingFunds(fundsRange, rateRange, 3, 100, storageRange);
+
+    // TC1: The worst and best cases are attained at the corners
+    EXPECT_NEAR(calculateFundsDuration(800.0, 1.25, 3, 0.75), runway.getLower(), EPSILON);
+    EXPECT_NEAR(calculateFundsDuration(1200.0, 0.8, 3, 0.0), runway.getUpper(), EPSILON);
+    EXPECT_NEAR(calculateTotalCost(1.25, 3, 100, 0.75), cost.getUpper(), EPSILON);
+
+    // TC2: Monte Carlo samples never leave the bounds
+    for (int i = 0; i < 10000; i++) {
+        double funds = sample(fundsRange);
+        double rate = sample(rateRange);
+        double storage = sample(storageRange);
+        ASSERT_TRUE(cost.contains(calculateTotalCost(rate, 3, 100, storage)));
+        ASSERT_TRUE(runway.contains(calculateFundsDuration(funds, rate, 3, storage)));
+        ASSERT_TRUE(remaining.contains(calculateRemainingFunds(funds, rate, 3, 100, storage)));
+    }
+}
+
+TEST(IntervalCalculators, FleetAndBatch) {
+    std::vector<IntervalGpuModel> gpuModels = {IntervalGpuModel("Test1", Interval(1.8, 2.2), Interval(1.0), 2),
+                                               IntervalGpuModel("Test2", Interval(3.0), Interval(1.2, 1.8), 3)};
+    std::vector<GpuModel> low = {GpuModel("Test1", 1.8, 1.0, 2), GpuModel("Test2", 3.0, 1.2, 3)};
+    std::vector<GpuModel> high = {GpuModel("Test1", 2.2, 1.0, 2), GpuModel("Test2", 3.0, 1.8, 3)};
+
+    // TC1: Fleet bounds are the fleet calculators at the corners
+    Interval cost = calculateTotalCostMultipleGpus(gpuModels, 50);
+    EXPECT_NEAR(calculateTotalCostMultipleGpus(low, 50), cost.getLower(), EPSILON);
+    EXPECT_NEAR(calculateTotalCostMultipleGpus(high, 50), cost.getUpper(), EPSILON);
+    Interval runway = calculateFundsDurationMultipleGpus(Interval(1000.0), gpuModels);
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(1000.0, high), runway.getLower(), EPSILON);
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(1000.0, low), runway.getUpper(), EPSILON);
+
+    // TC2: Batch form agrees with the scalar form
+    std::vector<Interval> funds = {Interval(100.0, 200.0), Interval(0.0, 50.0), Interval(10.0)};
+    std::vector<Interval> rates = {Interval(1.0, 2.0), Interval(0.0, 1.0), Interval(0.0)};
+    std::vector<int> instances = {1, 2, 3};
+    std::vector<Interval> storage = {Interval(0.5), Interval(0.0, 0.5), Interval(1.0)};
+    std::vector<Interval> durations(funds.size());
+    calculateFundsDurationBatch(funds.data(), rates.data(), instances.data(), storage.data(), funds.size(),
+                                durations.data());
+    for (std::size_t i = 0; i < funds.size(); i++) {
+        Interval expected = calculateFundsDuration(funds[i], rates[i], instances[i], storage[i]);
+        EXPECT_EQ(expected.getLower(), durations[i].getLower());
+        EXPECT_EQ(expected.getUpper(), durations[i].getUpper());
+    }
+    EXPECT_TRUE(std::isinf(durations[1].getUpper()));
+}
+
+TEST(IntervalCalculators, InputValidation) {
+    // TC1: Lower ends follow the scalar rules
+    EXPECT_THROW(calculateTotalCost(Interval(-0.1, 1.0), 1, 10, Interval(0.5)), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDuration(Interval(-1.0, 1.0), Interval(1.0), 1, Interval(0.5)), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDuration(Interval(1.0), Interval(1.0), 0, Interval(0.5)), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDurationMultipleGpus(Interval(1.0), {}), std::invalid_argument);
+
+    // TC2: Fleet totals check the list and rows like the double fleet calculators
+    EXPECT_THROW(calculateTotalCostMultipleGpus(std::vector<IntervalGpuModel>{}, 10), std::invalid_argument);
+    std::vector<IntervalGpuModel> fleet = {IntervalGpuModel("A100", Interval(1.0, 2.0), Interval(0.5), 1)};
+    EXPECT_THROW(calculateTotalCostMultipleGpus(fleet, -1), std::invalid_argument);
+    fleet.push_back(IntervalGpuModel("Bad", Interval(1.0), Interval(-0.5, 0.5), 1));
+    try {
+        calculateTotalCostMultipleGpus(fleet, 10);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ("GPU daily storage cost can't be negative", e.what());
+    }
+    fleet.back() = IntervalGpuModel("Bad", Interval(-0.1, 1.0), Interval(0.5), 1);
+    try {
+        calculateTotalCostMultipleGpus(fleet, 10);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ("GPU hourly rate can't be negative", e.what());
+    }
+    fleet.back() = IntervalGpuModel("Bad", Interval(1.0), Interval(0.5), 0);
+    EXPECT_THROW(calculateTotalCostMultipleGpus(fleet, 10), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDurationMultipleGpus(Interval(1.0), fleet), std::invalid_argument);
+}
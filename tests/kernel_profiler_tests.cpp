@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "../src/funds_calculator.h"
+#include "../src/kernel_profiler.h"
+
+// 1. Measurements
+TEST(KernelProfiler, AccumulatesPerKernel) {
+    KernelProfiler profiler;
+    volatile double sink = 0.0;
+
+    // TC1: Calls add up across measurements of the same kernel
+    for (int run = 0; run < 3; run++) {
+        profiler.measure("calculateTotalCost", 1000, [&]() {
+            for (int i = 0; i < 1000; i++) {
+                sink = sink + calculateTotalCost(1.0, 2, i, 0.5);
+            }
+        });
+    }
+    profiler.measure("calculateFundsDuration", 1, [&]() { sink = calculateFundsDuration(1000.0, 1.0, 5, 0.5); });
+
+    ASSERT_EQ(2u, profiler.getProfiles().size());
+    const KernelProfile& profile = profiler.getProfiles().at("calculateTotalCost");
+    EXPECT_EQ(3000u, profile.calls);
+    EXPECT_GT(profile.seconds, 0.0);
+
+    // TC2: Counters are either counting or left at zero
+    if (profiler.isCounterAvailable(HardwareCounter::Instructions)) {
+        EXPECT_GT(profile.counters[(std::size_t)(HardwareCounter::Instructions)], 0u);
+    } else {
+        EXPECT_EQ(0u, profile.counters[(std::size_t)(HardwareCounter::Instructions)]);
+    }
+}
+
+TEST(KernelProfiler, ClockOnlyReport) {
+    // TC1: Counters disabled falls back to timing and says so
+    KernelProfiler profiler(false);
+    EXPECT_FALSE(profiler.hasAnyCounters());
+    profiler.measure("calculateTotalCost", 10, []() {});
+
+    std::ostringstream out;
+    profiler.printReport(out);
+    std::string report = out.str();
+    EXPECT_NE(std::string::npos, report.find("calculateTotalCost"));
+    EXPECT_NE(std::string::npos, report.find("n/a"));
+    EXPECT_NE(std::string::npos, report.find("clock timing only"));
+}
+
+TEST(KernelProfiler, ScalesMultiplexedCounts) {
+    // TC1: A counter that ran the whole time is taken as is
+    EXPECT_EQ(1000u, scaleMultiplexedCount(1000, 500, 500));
+
+    // TC2: One that ran a quarter of the time is extrapolated to the whole
+    EXPECT_EQ(4000u, scaleMultiplexedCount(1000, 800, 200));
+
+    // TC3: One that never got the PMU counts nothing
+    EXPECT_EQ(0u, scaleMultiplexedCount(0, 800, 0));
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/gpu_model.h"
+#include "../src/offer_catalog.h"
+
+const double EPSILON = 0.001;
+
+static std::vector<GpuModel> makeCatalog(std::size_t count) {
+    const char* names[] = {"A100", "H100", "RTX3090", "RTX4090"};
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> rate(0.0, 4.0);
+    std::uniform_real_distribution<double> storage(0.0, 3.0);
+    std::uniform_int_distribution<int> instances(1, 8);
+
+    std::vector<GpuModel> offers;
+    for (std::size_t i = 0; i < count; i++) {
+        offers.push_back(GpuModel(names[i % 4], rate(rng), storage(rng), instances(rng)));
+    }
+    return offers;
+}
+
+static std::vector<OfferQuote> bruteForce(const std::vector<GpuModel>& offers, const std::string* name,
+                                          std::size_t k, int hours, int instances) {
+    std::vector<OfferQuote> quotes;
+    for (std::size_t i = 0; i < offers.size(); i++) {
+        if (name != nullptr && offers[i].getName() != *name) {
+            continue;
+        }
+        if (offers[i].getNumInstances() < instances) {
+            continue;
+        }
+        quotes.push_back({i, calculateTotalCost(offers[i].getHourlyRate(), instances, hours,
+                                                offers[i].getDailyStorageCost())});
+    }
+    std::sort(quotes.begin(), quotes.end(), [](const OfferQuote& a, const OfferQuote& b) {
+        return a.totalCost != b.totalCost ? a.totalCost < b.totalCost : a.offerIndex < b.offerIndex;
+    });
+    if (quotes.size() > k) {
+        quotes.resize(k);
+    }
+    return quotes;
+}
+
+// 1. Cheapest-k queries
+TEST(OfferCatalog, CheapestMatchesFullScan) {
+    std::vector<GpuModel> offers = makeCatalog(5000);
+    OfferCatalog catalog(offers, 4);
+    std::string h100 = "H100";
+
+    // TC1-TC4: Day-aligned and partial-day horizons, single and multiple instances
+    for (int hours : {1, 24, 50, 0}) {
+        for (int instances : {1, 4}) {
+            std::vector<OfferQuote> expected = bruteForce(offers, nullptr, 10, hours, instances);
+            std::vector<OfferQuote> actual = catalog.cheapest(10, hours, instances);
+            ASSERT_EQ(expected.size(), actual.size());
+            for (std::size_t i = 0; i < expected.size(); i++) {
+                EXPECT_NEAR(expected[i].totalCost, actual[i].totalCost, EPSILON);
+            }
+        }
+    }
+
+    // TC5: Name-filtered query only returns offers of that model
+    std::vector<OfferQuote> expected = bruteForce(offers, &h100, 5, 50, 2);
+    std::vector<OfferQuote> actual = catalog.cheapest(h100, 5, 50, 2);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ("H100", offers[actual[i].offerIndex].getName());
+        EXPECT_NEAR(expected[i].totalCost, actual[i].totalCost, EPSILON);
+    }
+
+    // TC6: Unknown model name
+    EXPECT_TRUE(catalog.cheapest("V100", 5, 50, 1).empty());
+
+    // TC7: Instance filter larger than every offer
+    EXPECT_TRUE(catalog.cheapest(5, 50, 9).empty());
+}
+
+TEST(OfferCatalog, CheapestKnownValues) {
+    std::vector<GpuModel> offers = {
+        GpuModel("A100", 2.0, 1.0, 2),
+        GpuModel("A100", 1.0, 0.5, 1),
+        GpuModel("H100", 3.0, 1.5, 3),
+    };
+    OfferCatalog catalog(offers, 1);
+
+    // TC1: Cheapest single instance for 50 hours
+    std::vector<OfferQuote> quotes = catalog.cheapest(2, 50, 1);
+    ASSERT_EQ(2u, quotes.size());
+    EXPECT_EQ(1u, quotes[0].offerIndex);
+    EXPECT_NEAR(51.5, quotes[0].totalCost, EPSILON);
+    EXPECT_EQ(0u, quotes[1].offerIndex);
+    EXPECT_NEAR(103.0, quotes[1].totalCost, EPSILON);
+
+    // TC2: k larger than the catalog
+    EXPECT_EQ(3u, catalog.cheapest(10, 50, 1).size());
+
+    // TC3: Invalid query input
+    EXPECT_THROW(catalog.cheapest(2, -1, 1), std::invalid_argument);
+    EXPECT_THROW(catalog.cheapest(2, 50, 0), std::invalid_argument);
+}
+
+// 2. Price-range queries
+TEST(OfferCatalog, PriceRange) {
+    std::vector<GpuModel> offers = makeCatalog(2000);
+    OfferCatalog catalog(offers, 3);
+
+    // TC1: Every returned offer lies in the range, in ascending order, and none are missed
+    std::vector<std::size_t> inRange = catalog.inPriceRange(1.0, 2.0);
+    std::size_t expectedCount = 0;
+    for (const auto& gpu : offers) {
+        double rate = gpu.getHourlyRate() + gpu.getDailyStorageCost() / 24.0;
+        if (rate >= 1.0 && rate <= 2.0) {
+            expectedCount++;
+        }
+    }
+    EXPECT_EQ(expectedCount, inRange.size());
+    double previous = 0.0;
+    for (std::size_t index : inRange) {
+        double rate = offers[index].getHourlyRate() + offers[index].getDailyStorageCost() / 24.0;
+        EXPECT_GE(rate, 1.0);
+        EXPECT_LE(rate, 2.0);
+        EXPECT_GE(rate, previous);
+        previous = rate;
+    }
+
+    // TC2: Name-filtered range
+    for (std::size_t index : catalog.inPriceRange("A100", 0.5, 1.5)) {
+        EXPECT_EQ("A100", offers[index].getName());
+    }
+
+    // TC3: Empty and inverted ranges
+    EXPECT_TRUE(catalog.inPriceRange(100.0, 200.0).empty());
+    EXPECT_TRUE(catalog.inPriceRange(2.0, 1.0).empty());
+}
+
+// 3. Index build
+TEST(OfferCatalog, BuildValidation) {
+    // TC1: Invalid offers are rejected with the calculator's messages
+    std::vector<GpuModel> offers = {GpuModel("Bad", -1.0, 0.5, 1)};
+    EXPECT_THROW(OfferCatalog catalog(offers), std::invalid_argument);
+
+    offers = {GpuModel("Bad", 1.0, 0.5, 0)};
+    EXPECT_THROW(OfferCatalog catalog(offers), std::invalid_argument);
+
+    // TC1.1: Non-finite offers never reach the sort, and the first bad row in catalog order
+    // decides the error whichever thread sees it
+    offers = makeCatalog(150000);
+    offers[140000] = GpuModel("Bad", -1.0, 0.5, 1);
+    offers[70000] = GpuModel("Bad", 1.0, std::nan(""), 1);
+    try {
+        OfferCatalog catalog(offers, 4);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ("GPU daily storage cost must be finite", e.what());
+    }
+    offers = {GpuModel("Bad", std::nan(""), 0.5, 1)};
+    EXPECT_THROW(OfferCatalog catalog(offers), std::invalid_argument);
+
+    // TC2: Partitions are listed in first-appearance order
+    offers = {GpuModel("B", 1.0, 0.0, 1), GpuModel("A", 1.0, 0.0, 1), GpuModel("B", 2.0, 0.0, 1)};
+    OfferCatalog catalog(offers);
+    EXPECT_EQ(3u, catalog.size());
+    EXPECT_EQ((std::vector<std::string>{"B", "A"}), catalog.getModelNames());
+
+    // TC3: Catalog large enough to need merging of sorted runs
+    offers = makeCatalog(150000);
+    OfferCatalog large(offers, 4);
+    std::vector<std::size_t> all = large.inPriceRange(0.0, 1000.0);
+    ASSERT_EQ(offers.size(), all.size());
+    for (std::size_t i = 1; i < all.size(); i++) {
+        double before = offers[all[i - 1]].getHourlyRate() + offers[all[i - 1]].getDailyStorageCost() / 24.0;
+        double after = offers[all[i]].getHourlyRate() + offers[all[i]].getDailyStorageCost() / 24.0;
+        ASSERT_LE(before, after);
+    }
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/gpu_model.h"
+#include "../src/pmr_fleet.h"
+
+const double EPSILON = 0.001;
+
+// Upstream resource that counts the blocks it hands out
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// 1. Range overloads of the multi-GPU calculators
+TEST(MultipleGpusRanges, MatchVectorVersions) {
+    std::vector<GpuModel> gpuModels = {
+        GpuModel("Test1", 2.0, 1.0, 2),
+        GpuModel("Test2", 3.0, 1.5, 3),
+        GpuModel("Test3", 1.0, 0.5, 1),
+    };
+
+    // TC1: Pointer pair over a plain array
+    const GpuModel* first = gpuModels.data();
+    const GpuModel* last = gpuModels.data() + gpuModels.size();
+    EXPECT_NEAR(721.0, calculateTotalCostMultipleGpus(first, last, 50), EPSILON);
+    EXPECT_NEAR(69.929, calculateFundsDurationMultipleGpus(1000.0, first, last), EPSILON);
+
+    // TC2: Arena-backed pmr fleet gives the same answers
+    FleetArena arena;
+    PmrFleet fleet = arena.makeFleet(3);
+    fleet.emplace_back("Test1", 2.0, 1.0, 2);
+    fleet.emplace_back("Test2", 3.0, 1.5, 3);
+    fleet.emplace_back("Test3", 1.0, 0.5, 1);
+    EXPECT_NEAR(calculateTotalCostMultipleGpus(gpuModels, 50),
+                calculateTotalCostMultipleGpus(fleet.begin(), fleet.end(), 50), EPSILON);
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(1000.0, gpuModels),
+                calculateFundsDurationMultipleGpus(1000.0, fleet.begin(), fleet.end()), EPSILON);
+
+    // TC3: Same validation as the vector versions
+    EXPECT_THROW(calculateTotalCostMultipleGpus(first, first, 50), std::invalid_argument);
+    EXPECT_THROW(calculateTotalCostMultipleGpus(first, last, -1), std::invalid_argument);
+    EXPECT_THROW(calculateFundsDurationMultipleGpus(-1.0, first, last), std::invalid_argument);
+    fleet.emplace_back("Bad", 1.0, 0.5, 0);
+    EXPECT_THROW(calculateFundsDurationMultipleGpus(1000.0, fleet.begin(), fleet.end()), std::invalid_argument);
+
+    // TC4: Zero-cost and zero-funds special cases
+    PmrFleet idle = arena.makeFleet();
+    idle.emplace_back("Idle", 0.0, 0.0, 2);
+    EXPECT_NEAR(-1.0, calculateFundsDurationMultipleGpus(1000.0, idle.begin(), idle.end()), EPSILON);
+    EXPECT_NEAR(0.0, calculateFundsDurationMultipleGpus(0.0, idle.begin(), idle.end()), EPSILON);
+}
+
+// 2. PmrGpuModel and FleetArena
+TEST(FleetArena, NamesAndRowsComeFromTheArena) {
+    CountingResource upstream;
+    {
+        FleetArena arena(1 << 16, &upstream);
+        PmrFleet fleet = arena.makeFleet();
+
+        // TC1: Long names (beyond the small-string buffer) and vector growth
+        for (int i = 0; i < 100000; i++) {
+            fleet.emplace_back("NVIDIA-H100-SXM5-80GB-node-" + std::to_string(i % 100), 2.0, 1.0, 1);
+        }
+        EXPECT_EQ(100000u, fleet.size());
+        EXPECT_EQ(arena.resource(), fleet[42].get_allocator().resource());
+        EXPECT_EQ("NVIDIA-H100-SXM5-80GB-node-42", std::string(fleet[42].getName()));
+
+        // TC2: Only a handful of upstream blocks for 100k rows
+        EXPECT_LT(upstream.allocations, 32u);
+    }
+}
+
+TEST(PmrGpuModel, Accessors) {
+    FleetArena arena;
+    PmrGpuModel gpu("A100", 1.5, 0.25, 4, arena.resource());
+
+    // TC1: Getters return constructor values
+    EXPECT_EQ("A100", std::string(gpu.getName()));
+    EXPECT_NEAR(1.5, gpu.getHourlyRate(), EPSILON);
+    EXPECT_NEAR(0.25, gpu.getDailyStorageCost(), EPSILON);
+    EXPECT_EQ(4, gpu.getNumInstances());
+
+    // TC2: Setters
+    gpu.setName("H100");
+    gpu.setHourlyRate(3.0);
+    gpu.setDailyStorageCost(1.0);
+    gpu.setNumInstances(2);
+    EXPECT_EQ("H100", std::string(gpu.getName()));
+    EXPECT_NEAR(3.0, gpu.getHourlyRate(), EPSILON);
+    EXPECT_NEAR(1.0, gpu.getDailyStorageCost(), EPSILON);
+    EXPECT_EQ(2, gpu.getNumInstances());
+
+    // TC3: Default constructor matches GpuModel defaults
+    PmrGpuModel defaults;
+    EXPECT_EQ("Default", std::string(defaults.getName()));
+    EXPECT_EQ(1, defaults.getNumInstances());
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/pricing_rule.h"
+
+const double EPSILON = 0.001;
+
+// 1. Built-in formula as a rule
+TEST(PricingRule, DefaultFormulaMatchesCalculateTotalCost) {
+    PricingRule rule("rate * instances * hours + storage * instances * days");
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> rate(0.0, 5.0);
+    std::uniform_real_distribution<double> storage(0.0, 3.0);
+    std::uniform_int_distribution<int> instances(1, 32);
+    std::uniform_int_distribution<int> hours(0, 2000);
+
+    std::vector<double> rates, storageCosts;
+    std::vector<int> counts, runningHours;
+    for (int i = 0; i < 1000; i++) {
+        rates.push_back(rate(rng));
+        storageCosts.push_back(storage(rng));
+        counts.push_back(instances(rng));
+        runningHours.push_back(hours(rng));
+    }
+    std::vector<double> costs(rates.size());
+    rule.evaluateBatch(rates.data(), counts.data(), runningHours.data(), storageCosts.data(), rates.size(),
+                       costs.data());
+
+    // TC1: Same cents as the hard-coded formula, across several blocks
+    for (std::size_t i = 0; i < costs.size(); i++) {
+        ASSERT_NEAR(calculateTotalCost(rates[i], counts[i], runningHours[i], storageCosts[i]), costs[i], EPSILON);
+    }
+
+    // TC2: Single evaluation
+    EXPECT_NEAR(206.0, rule.evaluate(2.0, 2, 50, 1.0), EPSILON);
+}
+
+// 2. Contract features
+TEST(PricingRule, TiersMinimumsAndDiscounts) {
+    // 10% off the hourly rate from 8 instances, storage half price after a week, $25 minimum
+    PricingRule rule("max(25, if(instances >= 8, rate * 0.9, rate) * instances * hours"
+                     " + storage * instances * min(days, 7) + storage * 0.5 * instances * max(days - 7, 0))");
+
+    // TC1: Below the tier and the minimum
+    EXPECT_NEAR(25.0, rule.evaluate(1.0, 1, 10, 0.5), EPSILON);
+
+    // TC2: In the volume tier
+    EXPECT_NEAR(0.9 * 8 * 100 + 0.5 * 8 * 5, rule.evaluate(1.0, 8, 100, 0.5), EPSILON);
+
+    // TC3: Discounted storage after day 7 (240 hours = 10 days)
+    EXPECT_NEAR(2 * 240 + 1.0 * 2 * 7 + 0.5 * 2 * 3, rule.evaluate(1.0, 2, 240, 1.0), EPSILON);
+
+    // TC4: Comparisons, unary minus, floor and ceil
+    EXPECT_NEAR(1.0, PricingRule("(hours <= 24) == 1").evaluate(1.0, 1, 24, 0.0), EPSILON);
+    EXPECT_NEAR(3.0, PricingRule("-floor(-2.5) + ceil(0) * rate").evaluate(1.0, 1, 1, 0.0), EPSILON);
+    EXPECT_NEAR(12.0, PricingRule("12").evaluate(1.0, 1, 1, 0.0), EPSILON);
+}
+
+TEST(PricingRule, FoldsConstants) {
+    // TC1: Constant arithmetic disappears; only the multiply by rate remains
+    PricingRule rule("rate * (2 * 3 + 4 / 2)");
+    EXPECT_EQ(1u, rule.getInstructionCount());
+    EXPECT_NEAR(16.0, rule.evaluate(2.0, 1, 1, 0.0), EPSILON);
+}
+
+TEST(PricingRule, ScalarMatchesBatch) {
+    // A long rule needs more registers than evaluate() keeps on the stack
+    std::string longRule = "rate * instances * hours";
+    for (int i = 0; i < 100; i++) {
+        longRule += " + storage * days * " + std::to_string(i % 7) + " / (instances + " + std::to_string(i) + ")";
+    }
+    std::vector<double> rates = {0.0, 0.5, 1.25, 3.0};
+    std::vector<int> instances = {1, 2, 7, 16};
+    std::vector<int> hours = {0, 23, 24, 500};
+    std::vector<double> storage = {0.0, 0.3, 1.0, 2.5};
+
+    // TC1: Same cents one row at a time as in a batch, for short and long rules
+    for (const std::string& source : {std::string("if(hours > 24, 0.9, 1) * rate * instances * hours"), longRule}) {
+        PricingRule rule(source);
+        std::vector<double> costs(rates.size());
+        rule.evaluateBatch(rates.data(), instances.data(), hours.data(), storage.data(), rates.size(), costs.data());
+        for (std::size_t i = 0; i < rates.size(); i++) {
+            EXPECT_EQ(costs[i], rule.evaluate(rates[i], instances[i], hours[i], storage[i]));
+        }
+    }
+}
+
+TEST(PricingRule, RejectsBadRules) {
+    // TC1: Syntax errors
+    EXPECT_THROW(PricingRule("rate *"), std::invalid_argument);
+    EXPECT_THROW(PricingRule("(rate + 1"), std::invalid_argument);
+    EXPECT_THROW(PricingRule("rate 1"), std::invalid_argument);
+    EXPECT_THROW(PricingRule(""), std::invalid_argument);
+
+    // TC2: Unknown names and wrong argument counts
+    EXPECT_THROW(PricingRule("price * hours"), std::invalid_argument);
+    EXPECT_THROW(PricingRule("min(rate)"), std::invalid_argument);
+    EXPECT_THROW(PricingRule("if(rate, 1)"), std::invalid_argument);
+
+    // TC3: The message says where
+    try {
+        PricingRule("rate + cost");
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ("Pricing rule: unknown name 'cost' at position 7", e.what());
+    }
+
+    // TC4: Inputs follow calculateTotalCost's rules
+    PricingRule rule("rate * hours");
+    EXPECT_THROW(rule.evaluate(1.0, 0, 1, 0.0), std::invalid_argument);
+    EXPECT_THROW(rule.evaluate(-1.0, 1, 1, 0.0), std::invalid_argument);
+    EXPECT_THROW(rule.evaluate(1.0, 1, -1, 0.0), std::invalid_argument);
+}
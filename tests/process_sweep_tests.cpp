@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/process_sweep.h"
+
+const double EPSILON = 0.001;
+
+static std::vector<SweepScenario> makeGrid() {
+    std::vector<SweepScenario> scenarios;
+    for (int hours = 0; hours < 200; hours += 7) {
+        for (int instances = 1; instances <= 8; instances++) {
+            for (double rate : {0.0, 0.5, 1.25, 3.0}) {
+                scenarios.push_back(SweepScenario{1000.0 + hours, rate, 0.5, instances, hours});
+            }
+        }
+    }
+    return scenarios;
+}
+
+static void expectMatchesCalculators(const std::vector<SweepScenario>& scenarios,
+                                     const std::vector<SweepResult>& results) {
+    ASSERT_EQ(scenarios.size(), results.size());
+    for (std::size_t i = 0; i < scenarios.size(); i++) {
+        const SweepScenario& s = scenarios[i];
+        double totalCost = calculateTotalCost(s.hourlyRate, s.numInstances, s.runningHours, s.dailyStorageCost);
+        ASSERT_NEAR(totalCost, results[i].totalCost, EPSILON);
+        ASSERT_NEAR(s.initialFunds - totalCost, results[i].remainingFunds, EPSILON);
+        ASSERT_NEAR(calculateFundsDuration(s.initialFunds, s.hourlyRate, s.numInstances, s.dailyStorageCost),
+                    results[i].fundsDuration, EPSILON);
+    }
+}
+
+// 1. Sweeps across worker processes
+TEST(ProcessSweep, MatchesCalculators) {
+    std::vector<SweepScenario> scenarios = makeGrid();
+    ProcessSweepConfig config;
+    config.workerCount = 3;
+    config.shardSize = 50;
+    ProcessSweepStats stats;
+
+    // TC1: Every scenario priced, in order
+    expectMatchesCalculators(scenarios, runProcessSweep(scenarios, config, &stats));
+    EXPECT_EQ(3u, stats.workersStarted);
+    EXPECT_EQ(0u, stats.workerFailures);
+
+    // TC2: Empty sweep
+    EXPECT_TRUE(runProcessSweep({}, config).empty());
+}
+
+TEST(ProcessSweep, ReassignsShardsOfCrashedWorkers) {
+    std::vector<SweepScenario> scenarios = makeGrid();
+    ProcessSweepConfig config;
+    config.workerCount = 2;
+    config.shardSize = 40;
+    // The first worker to take shard 4 or 9 dies with it
+    config.beforeShard = [](std::size_t shard, unsigned attempt) {
+        if ((shard == 4 || shard == 9) && attempt == 0) {
+            std::raise(SIGKILL);
+        }
+    };
+    ProcessSweepStats stats;
+
+    // TC1: The sweep still completes with correct results
+    expectMatchesCalculators(scenarios, runProcessSweep(scenarios, config, &stats));
+    EXPECT_EQ(2u, stats.workerFailures);
+    EXPECT_EQ(2u, stats.shardsRetried);
+    EXPECT_EQ(4u, stats.workersStarted);
+
+    // TC2: A shard that always kills its worker fails the sweep after maxAttempts
+    config.beforeShard = [](std::size_t shard, unsigned) {
+        if (shard == 2) {
+            std::raise(SIGKILL);
+        }
+    };
+    config.maxAttempts = 2;
+    EXPECT_THROW(runProcessSweep(scenarios, config), std::runtime_error);
+}
+
+TEST(ProcessSweep, InputValidation) {
+    // TC1: Scenarios are checked before any worker starts
+    EXPECT_THROW(runProcessSweep({SweepScenario{100.0, -1.0, 0.5, 1, 10}}), std::invalid_argument);
+    EXPECT_THROW(runProcessSweep({SweepScenario{-1.0, 1.0, 0.5, 1, 10}}), std::invalid_argument);
+
+    // TC2: Config
+    ProcessSweepConfig config;
+    config.shardSize = 0;
+    EXPECT_THROW(runProcessSweep({SweepScenario{100.0, 1.0, 0.5, 1, 10}}, config), std::invalid_argument);
+}
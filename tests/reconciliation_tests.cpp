@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/reconciliation.h"
+
+const double EPSILON = 0.001;
+
+namespace {
+
+// An export billing every predicted instance-hour exactly: each day's storage on its first hour
+std::vector<BillingCharge> exactExport(const std::vector<GpuModel>& gpuModels, int runningHours) {
+    StringInterner models = makeFleetInterner(gpuModels);
+    std::vector<std::uint32_t> nextInstance(models.size(), 0);
+    std::vector<BillingCharge> charges;
+    for (const auto& gpu : gpuModels) {
+        std::uint32_t modelId = models.find(gpu.getName());
+        for (int i = 0; i < gpu.getNumInstances(); i++) {
+            std::uint32_t instance = nextInstance[modelId]++;
+            for (int hour = 0; hour < runningHours; hour++) {
+                double amount = gpu.getHourlyRate() + (hour % 24 == 0 ? gpu.getDailyStorageCost() : 0.0);
+                charges.push_back(BillingCharge{modelId, instance, (std::uint32_t)(hour), amount});
+            }
+        }
+    }
+    return charges;
+}
+
+} // namespace
+
+// 1. Parsing export rows
+TEST(ParseBillingCharge, Fields) {
+    std::vector<GpuModel> gpuModels = {GpuModel("RTX 4090", 0.5, 0.2, 2)};
+    StringInterner models = makeFleetInterner(gpuModels);
+    BillingCharge charge;
+    std::string error;
+
+    // TC1: Known model
+    ASSERT_TRUE(parseBillingCharge(" RTX 4090 , 1, 30, 0.5\r", models, charge, error));
+    EXPECT_EQ(0u, charge.modelId);
+    EXPECT_EQ(1u, charge.instance);
+    EXPECT_EQ(30u, charge.hour);
+    EXPECT_NEAR(0.5, charge.amount, EPSILON);
+
+    // TC2: Unknown model parses, with no id
+    ASSERT_TRUE(parseBillingCharge("A100,0,0,1.0", models, charge, error));
+    EXPECT_EQ(StringInterner::NOT_FOUND, charge.modelId);
+
+    // TC3: Malformed rows
+    EXPECT_FALSE(parseBillingCharge("RTX 4090,1,30", models, charge, error));
+    EXPECT_EQ("Expected 4 comma-separated fields", error);
+    EXPECT_FALSE(parseBillingCharge("RTX 4090,-1,30,0.5", models, charge, error));
+    EXPECT_EQ("Invalid instance number", error);
+    EXPECT_FALSE(parseBillingCharge("RTX 4090,1,x,0.5", models, charge, error));
+    EXPECT_EQ("Invalid hour", error);
+    EXPECT_FALSE(parseBillingCharge("RTX 4090,1,30,nan", models, charge, error));
+    EXPECT_EQ("Invalid charge amount", error);
+}
+
+TEST(ReadBillingExport, BufferAndFile) {
+    std::vector<GpuModel> gpuModels = {GpuModel("A100", 2.0, 1.0, 3), GpuModel("V100", 1.0, 0.5, 2)};
+    StringInterner models = makeFleetInterner(gpuModels);
+    std::vector<BillingCharge> charges = exactExport(gpuModels, 50);
+    std::string text = "model,instance,hour,amount\n# exported\n";
+    for (const BillingCharge& charge : charges) {
+        text += models.nameOf(charge.modelId) + "," + std::to_string(charge.instance) + "," +
+                std::to_string(charge.hour) + "," + std::to_string(charge.amount) + "\n";
+    }
+    text += "A100,1,x,2.0\n\nT4,0,0,1.5";
+
+    // TC1: Every row in file order, unknown models kept, bad rows reported by line
+    CsvIngestConfig config;
+    config.chunkBytes = 1000;
+    config.threadCount = 3;
+    BillingExport exported = readBillingExportBuffer(text.data(), text.size(), models, config);
+    ASSERT_EQ(charges.size() + 1, exported.charges.size());
+    for (std::size_t i = 0; i < charges.size(); i++) {
+        EXPECT_EQ(charges[i].modelId, exported.charges[i].modelId);
+        EXPECT_EQ(charges[i].instance, exported.charges[i].instance);
+        EXPECT_EQ(charges[i].hour, exported.charges[i].hour);
+        EXPECT_NEAR(charges[i].amount, exported.charges[i].amount, EPSILON);
+    }
+    EXPECT_EQ(StringInterner::NOT_FOUND, exported.charges.back().modelId);
+    EXPECT_EQ(1u, exported.errorRows);
+    ASSERT_EQ(1u, exported.errors.size());
+    EXPECT_EQ(charges.size() + 3, exported.errors[0].lineNumber);
+    EXPECT_EQ("Invalid hour", exported.errors[0].message);
+    EXPECT_EQ(charges.size() + 5, exported.lineCount);
+
+    // TC2: The mapped file reads the same and reconciles like the in-memory charges
+    std::string path = testing::TempDir() + "billing_export_test.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+    BillingExport fromFile = readBillingExport(path, models);
+    EXPECT_EQ(exported.charges.size(), fromFile.charges.size());
+    EXPECT_EQ(exported.lineCount, fromFile.lineCount);
+    ReconciliationReport report = reconcileBilling(gpuModels, 50, fromFile.charges, 0.01);
+    EXPECT_EQ(5u * 3u, report.matchedKeys);
+    EXPECT_EQ(0u, report.unbilledKeys);
+    EXPECT_EQ(1u, report.unexpectedKeys);
+    EXPECT_NEAR(reconcileBilling(gpuModels, 50, charges, 0.01).totalPredicted, report.totalPredicted, EPSILON);
+    std::remove(path.c_str());
+
+    // TC3: Missing files throw
+    EXPECT_THROW(readBillingExport(path, models), std::runtime_error);
+}
+
+// 2. Joining against predictions
+TEST(ReconcileBilling, ExactExportMatches) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2), GpuModel("Test2", 3.0, 1.5, 3),
+                                       GpuModel("Test1", 2.0, 1.0, 1)};
+    std::vector<BillingCharge> charges = exactExport(gpuModels, 50);
+
+    ReconciliationReport report = reconcileBilling(gpuModels, 50, charges, 0.01);
+
+    // TC1: Every instance-day matches and the totals agree with the fleet calculator
+    EXPECT_EQ(2u, report.models.size());
+    EXPECT_EQ(6u * 3u, report.matchedKeys);
+    EXPECT_EQ(0u, report.unbilledKeys);
+    EXPECT_EQ(0u, report.unexpectedKeys);
+    EXPECT_TRUE(report.flagged.empty());
+    EXPECT_NEAR(calculateTotalCostMultipleGpus(gpuModels, 50), report.totalPredicted, EPSILON);
+    EXPECT_NEAR(report.totalPredicted, report.totalBilled, EPSILON);
+    EXPECT_EQ("Test1", report.models[0].name);
+    EXPECT_NEAR(3 * (2.0 * 50 + 1.0 * 3), report.models[0].billed, EPSILON);
+}
+
+TEST(ReconcileBilling, FlagsDiscrepancies) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2)};
+    std::vector<BillingCharge> charges = exactExport(gpuModels, 48);
+
+    // Overbill instance 1 on day 1, drop instance 0's day 0, bill an hour past the run and an unknown model
+    charges.push_back(BillingCharge{0, 1, 30, 5.0});
+    charges.erase(std::remove_if(charges.begin(), charges.end(),
+                                 [](const BillingCharge& c) { return c.instance == 0 && c.hour < 24; }),
+                  charges.end());
+    charges.push_back(BillingCharge{0, 0, 48, 2.0});
+    charges.push_back(BillingCharge{StringInterner::NOT_FOUND, 0, 0, 7.0});
+    // Within tolerance
+    charges.push_back(BillingCharge{0, 1, 0, 0.005});
+
+    ReconciliationReport report = reconcileBilling(gpuModels, 48, charges, 0.01);
+
+    // TC1: Counts
+    EXPECT_EQ(3u, report.matchedKeys);
+    EXPECT_EQ(1u, report.unbilledKeys);
+    EXPECT_EQ(2u, report.unexpectedKeys);
+
+    // TC2: Flagged keys in key order
+    ASSERT_EQ(4u, report.flagged.size());
+    EXPECT_EQ(0u, report.flagged[0].instance);
+    EXPECT_EQ(0u, report.flagged[0].day);
+    EXPECT_NEAR(0.0, report.flagged[0].billed, EPSILON);
+    EXPECT_NEAR(49.0, report.flagged[0].predicted, EPSILON);
+    EXPECT_EQ(2u, report.flagged[1].day);
+    EXPECT_EQ(1u, report.flagged[2].instance);
+    EXPECT_EQ(1u, report.flagged[2].day);
+    EXPECT_NEAR(54.0, report.flagged[2].billed, EPSILON);
+    EXPECT_EQ(StringInterner::NOT_FOUND, report.flagged[3].modelId);
+
+    // TC3: Per-model aggregates, with an entry for the unknown model
+    ASSERT_EQ(2u, report.models.size());
+    EXPECT_NEAR(5.0 + 2.0, report.models[0].overbilled, EPSILON);
+    EXPECT_NEAR(49.0, report.models[0].underbilled, EPSILON);
+    EXPECT_EQ(3u, report.models[0].flaggedKeys);
+    EXPECT_EQ("(unknown)", report.models[1].name);
+    EXPECT_NEAR(7.0, report.models[1].overbilled, EPSILON);
+}
+
+TEST(ReconcileBilling, ThreadCountDoesNotChangeResult) {
+    std::vector<GpuModel> gpuModels;
+    for (int i = 0; i < 20; i++) {
+        gpuModels.push_back(GpuModel("Model" + std::to_string(i % 7), 0.1 * (i + 1), 0.05 * i, 1 + i % 4));
+    }
+    std::vector<BillingCharge> charges = exactExport(gpuModels, 24 * 30 + 5);
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<std::size_t> pick(0, charges.size() - 1);
+    for (int i = 0; i < 500; i++) {
+        charges[pick(rng)].amount += 0.25;
+    }
+
+    ReconciliationReport serial = reconcileBilling(gpuModels, 24 * 30 + 5, charges, 0.01, 1);
+    ReconciliationReport parallel = reconcileBilling(gpuModels, 24 * 30 + 5, charges, 0.01, 4);
+
+    // TC1: Identical flagged keys and bit-identical sums
+    ASSERT_EQ(serial.flagged.size(), parallel.flagged.size());
+    EXPECT_FALSE(serial.flagged.empty());
+    for (std::size_t i = 0; i < serial.flagged.size(); i++) {
+        EXPECT_EQ(serial.flagged[i].instance, parallel.flagged[i].instance);
+        EXPECT_EQ(serial.flagged[i].billed, parallel.flagged[i].billed);
+    }
+    EXPECT_EQ(serial.totalBilled, parallel.totalBilled);
+    EXPECT_EQ(serial.matchedKeys, parallel.matchedKeys);
+}
+
+TEST(ReconcileBilling, InputValidation) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2)};
+
+    // TC1: Negative hours, negative tolerance, invalid fleet row
+    EXPECT_THROW(reconcileBilling(gpuModels, -1, {}, 0.01), std::invalid_argument);
+    EXPECT_THROW(reconcileBilling(gpuModels, 24, {}, -0.01), std::invalid_argument);
+    gpuModels.push_back(GpuModel("Test2", -1.0, 1.0, 1));
+    EXPECT_THROW(reconcileBilling(gpuModels, 24, {}, 0.01), std::invalid_argument);
+}
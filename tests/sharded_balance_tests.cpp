@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/sharded_balance.h"
+
+const double EPSILON = 0.001;
+
+// 1. Single-threaded semantics
+TEST(ShardedBalance, ChargesAndRejects) {
+    ShardedBalance balance(10.0, 4, 100);
+
+    // TC1: Charges within the balance succeed
+    EXPECT_TRUE(balance.tryCharge(2.5));
+    EXPECT_TRUE(balance.tryChargeCents(250));
+    EXPECT_NEAR(5.0, balance.exactRemaining(), EPSILON);
+    EXPECT_NEAR(5.0, balance.approximateRemaining(), EPSILON);
+
+    // TC2: A charge larger than the balance is refused and changes nothing
+    EXPECT_FALSE(balance.tryCharge(5.01));
+    EXPECT_NEAR(5.0, balance.exactRemaining(), EPSILON);
+
+    // TC3: Exactly the balance drains it
+    EXPECT_TRUE(balance.tryCharge(5.0));
+    EXPECT_NEAR(0.0, balance.exactRemaining(), EPSILON);
+    EXPECT_FALSE(balance.tryChargeCents(1));
+
+    // TC4: Zero charge always succeeds; negative input is invalid
+    EXPECT_TRUE(balance.tryCharge(0.0));
+    EXPECT_THROW(balance.tryCharge(-1.0), std::invalid_argument);
+    EXPECT_THROW(ShardedBalance(-1.0), std::invalid_argument);
+}
+
+TEST(ShardedBalance, CalculateRemainingFundsSemantics) {
+    // TC1: Covered cost is deducted, same as the scalar calculator
+    ShardedBalance balance(1000.0, 2);
+    EXPECT_NEAR(calculateRemainingFunds(1000.0, 1.0, 5, 50, 0.5),
+                calculateRemainingFunds(balance, 1.0, 5, 50, 0.5), EPSILON);
+
+    // TC2: Insufficient funds return the balance unchanged
+    ShardedBalance small(10.0, 2);
+    EXPECT_NEAR(10.0, calculateRemainingFunds(small, 1.0, 5, 50, 0.5), EPSILON);
+    EXPECT_NEAR(calculateRemainingFunds(10.0, 1.0, 5, 50, 0.5), small.exactRemaining(), EPSILON);
+
+    // TC3: Invalid cost inputs throw like calculateTotalCost
+    EXPECT_THROW(calculateRemainingFunds(small, -1.0, 5, 50, 0.5), std::invalid_argument);
+}
+
+// 2. Concurrent charging
+TEST(ShardedBalance, ConcurrentChargesNeverOverdraw) {
+    const int threads = 8;
+    const int attemptsPerThread = 20000;
+    ShardedBalance balance(1000.0, 4);  // 100000 cents, 160000 attempted
+    std::atomic<long long> accepted(0);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < attemptsPerThread; i++) {
+                if (balance.tryChargeCents(1)) {
+                    accepted++;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // TC1: Every accepted charge is counted once and the balance never goes negative
+    EXPECT_EQ(accepted.load(), balance.exactSpentCents());
+    EXPECT_GE(balance.exactRemaining(), 0.0);
+
+    // TC2: No cent is lost in shard allowances; the rest can still be charged
+    while (balance.tryChargeCents(1)) {
+        accepted++;
+    }
+    EXPECT_EQ(100000, accepted.load());
+    EXPECT_NEAR(0.0, balance.exactRemaining(), EPSILON);
+}
+
+TEST(ShardedBalance, ExactReadsFinishUnderSteadyCharging) {
+    const int threads = 4;
+    ShardedBalance balance(100000.0, 4);
+    std::atomic<bool> stop(false);
+    std::atomic<long long> accepted(0);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (balance.tryChargeCents(1)) {
+                    accepted++;
+                }
+            }
+        });
+    }
+
+    // TC1: Reads return while charges keep landing, and the spent total never goes backwards
+    long long previous = 0;
+    for (int i = 0; i < 2000; i++) {
+        long long spent = balance.exactSpentCents();
+        EXPECT_GE(spent, previous);
+        previous = spent;
+    }
+    stop = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // TC2: Parking the funds for a read loses no cent
+    EXPECT_EQ(accepted.load(), balance.exactSpentCents());
+    EXPECT_NEAR(100000.0 - accepted.load() / 100.0, balance.exactRemaining(), EPSILON);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/shutdown_runway.h"
+#include "../src/funds_calculator.h"
+
+const double EPSILON = 0.001;
+
+// 1. Shutdown schedule
+TEST(ShutdownSchedule, NoThresholdsRunsWholeFleetToZero) {
+    std::vector<GpuModel> gpuModels = {GpuModel("A100", 2.0, 24.0, 2), GpuModel("V100", 1.0, 0.0, 1)};
+    std::vector<ShutdownRule> rules(2);
+
+    // TC1: Storage is charged at day start, so the runway is the fleet's ordinary runway
+    ShutdownSchedule schedule = calculateShutdownSchedule(700.0, gpuModels, rules);
+    double expected = calculateFundsDurationMultipleGpus(700.0, gpuModels);
+    EXPECT_NEAR(expected, schedule.runwayHours, EPSILON);
+    EXPECT_NEAR(expected, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(expected, schedule.stopHours[1], EPSILON);
+    ASSERT_EQ(1u, schedule.segments.size());
+    EXPECT_NEAR(5.0, schedule.segments[0].hourlyRate, EPSILON);
+    EXPECT_NEAR(48.0, schedule.segments[0].dailyStorageCost, EPSILON);
+
+    // TC2: No funds stops everything at once
+    EXPECT_NEAR(0.0, calculateShutdownSchedule(0.0, gpuModels, rules).runwayHours, EPSILON);
+}
+
+TEST(ShutdownSchedule, ZeroThresholdsMatchFleetRunway) {
+    std::vector<std::vector<GpuModel>> fleets = {
+        {GpuModel("A100", 2.0, 24.0, 2), GpuModel("V100", 1.0, 0.0, 1)},
+        {GpuModel("A100", 1.5, 10.0, 3), GpuModel("H100", 4.0, 30.0, 1), GpuModel("T4", 0.3, 2.0, 4)},
+        {GpuModel("Cold", 0.0, 12.0, 2)},
+        {GpuModel("Hot", 3.0, 0.0, 2)},
+    };
+
+    // TC1: Whatever the funds, the sweep agrees with calculateFundsDurationMultipleGpus
+    for (const auto& gpuModels : fleets) {
+        std::vector<ShutdownRule> rules(gpuModels.size());
+        for (double funds : {0.0, 10.0, 47.0, 48.0, 700.0, 1234.5, 50000.0}) {
+            double expected = calculateFundsDurationMultipleGpus(funds, gpuModels);
+            EXPECT_NEAR(expected, calculateShutdownSchedule(funds, gpuModels, rules).runwayHours, EPSILON);
+        }
+    }
+}
+
+TEST(ShutdownSchedule, LowPriorityModelsStopFirst) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Batch", 2.0, 0.0, 1), GpuModel("Serving", 3.0, 24.0, 1),
+                                       GpuModel("Dev", 1.0, 0.0, 1)};
+    std::vector<ShutdownRule> rules = {{500.0, 1}, {0.0, 5}, {500.0, 0}};
+
+    // TC1: All three spend 24 + 6/hour per day down to 500 (four days plus 2/3 hour), then
+    // Serving finishes the paid day and spends 24 + 3/hour per day to zero
+    ShutdownSchedule schedule = calculateShutdownSchedule(1200.0, gpuModels, rules);
+    EXPECT_NEAR(96.0 + 2.0 / 3.0, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(96.0 + 2.0 / 3.0, schedule.stopHours[2], EPSILON);
+    EXPECT_NEAR(216.0 + 22.0 / 3.0, schedule.stopHours[1], EPSILON);
+    EXPECT_NEAR(216.0 + 22.0 / 3.0, schedule.runwayHours, EPSILON);
+    EXPECT_EQ((std::vector<std::size_t>{2, 0, 1}), schedule.stopOrder);
+    ASSERT_EQ(2u, schedule.segments.size());
+    EXPECT_NEAR(500.0, schedule.segments[0].endBalance, EPSILON);
+    EXPECT_NEAR(500.0, schedule.segments[1].startBalance, EPSILON);
+    EXPECT_EQ(1u, schedule.segments[1].runningModels);
+
+    // TC2: Starting below a threshold stops that model immediately; Serving then runs four
+    // days and stops at the day start whose storage it can't pay
+    schedule = calculateShutdownSchedule(400.0, gpuModels, rules);
+    EXPECT_NEAR(0.0, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(96.0, schedule.stopHours[1], EPSILON);
+
+    // TC3: A threshold crossed by a storage charge stops its models at that day start, before it
+    schedule = calculateShutdownSchedule(500.0 + 168.0 + 10.0, gpuModels, rules);
+    EXPECT_NEAR(24.0, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(510.0, schedule.segments[0].endBalance, EPSILON);
+}
+
+TEST(ShutdownSchedule, FreeModelsNeverStop) {
+    std::vector<GpuModel> gpuModels = {GpuModel("Paid", 1.0, 0.0, 1), GpuModel("Free", 0.0, 0.0, 1)};
+    std::vector<ShutdownRule> rules = {{100.0, 0}, {0.0, 0}};
+
+    // TC1: Once the paid model stops, the balance stays at 100
+    ShutdownSchedule schedule = calculateShutdownSchedule(200.0, gpuModels, rules);
+    EXPECT_NEAR(100.0, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(-1.0, schedule.stopHours[1], EPSILON);
+    EXPECT_NEAR(-1.0, schedule.runwayHours, EPSILON);
+
+    // TC2: A free model already below its threshold stops at once
+    schedule = calculateShutdownSchedule(400.0, {GpuModel("Free", 0.0, 0.0, 1)}, {{500.0, 0}});
+    EXPECT_NEAR(0.0, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(0.0, schedule.runwayHours, EPSILON);
+    EXPECT_TRUE(schedule.segments.empty());
+
+    // TC3: In an all-free fleet, only models whose threshold the balance is at or below stop
+    schedule = calculateShutdownSchedule(400.0, {GpuModel("Free", 0.0, 0.0, 1), GpuModel("Idle", 0.0, 0.0, 2)},
+                                         {{400.0, 0}, {100.0, 0}});
+    EXPECT_NEAR(0.0, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(-1.0, schedule.stopHours[1], EPSILON);
+    EXPECT_NEAR(-1.0, schedule.runwayHours, EPSILON);
+
+    // TC4: A free model left when the paid one stops is stopped if the balance is at its threshold
+    schedule = calculateShutdownSchedule(200.0, gpuModels, {{100.0, 0}, {100.0, 1}});
+    EXPECT_NEAR(100.0, schedule.stopHours[0], EPSILON);
+    EXPECT_NEAR(100.0, schedule.stopHours[1], EPSILON);
+    EXPECT_NEAR(100.0, schedule.runwayHours, EPSILON);
+}
+
+TEST(ShutdownSchedule, LargeFleetMatchesSegmentSum) {
+    std::vector<GpuModel> gpuModels;
+    std::vector<ShutdownRule> rules;
+    for (int i = 0; i < 10000; i++) {
+        gpuModels.push_back(GpuModel("GPU", 1.0, 0.0, 1));
+        rules.push_back(ShutdownRule{(double)(i % 100) * 10.0, i % 7});
+    }
+
+    // TC1: Each segment spends exactly the balance between consecutive thresholds
+    ShutdownSchedule schedule = calculateShutdownSchedule(5000.0, gpuModels, rules);
+    EXPECT_EQ(10000u, schedule.stopOrder.size());
+    double spent = 0.0;
+    for (const RunwaySegment& segment : schedule.segments) {
+        spent += (segment.endHour - segment.startHour) * segment.hourlyRate;
+    }
+    EXPECT_NEAR(5000.0, spent, EPSILON);
+}
+
+TEST(ShutdownSchedule, InputValidation) {
+    std::vector<GpuModel> gpuModels = {GpuModel("A100", 2.0, 1.0, 2)};
+
+    // TC1: Rules must line up with models
+    EXPECT_THROW(calculateShutdownSchedule(100.0, gpuModels, {}), std::invalid_argument);
+
+    // TC2: Negative values
+    EXPECT_THROW(calculateShutdownSchedule(100.0, gpuModels, {{-1.0, 0}}), std::invalid_argument);
+    EXPECT_THROW(calculateShutdownSchedule(-1.0, gpuModels, {{0.0, 0}}), std::invalid_argument);
+    EXPECT_THROW(calculateShutdownSchedule(100.0, {GpuModel("Bad", -1.0, 0.0, 1)}, {{0.0, 0}}), std::invalid_argument);
+}
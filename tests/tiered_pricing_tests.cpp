@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/tiered_pricing.h"
+
+const double EPSILON = 0.001;
+
+// Day-by-day reference for the tiered duration: pay storage, then run hour by hour at the tier rate
+static double referenceDuration(double funds, const TieredRateTable& rates, int instances, double storage) {
+    double hours = 0.0;
+    for (int day = 0; day < 100000; day++) {
+        funds -= storage * instances;
+        if (funds <= 0) {
+            return hours;
+        }
+        for (int hour = 0; hour < 24; hour++) {
+            double cost = rates.hourlyRateAt(instances, hours) * instances;
+            if (cost >= funds) {
+                return hours + funds / cost;
+            }
+            funds -= cost;
+            hours += 1.0;
+        }
+    }
+    return -1;
+}
+
+// 1. Flat tables agree with the flat calculators
+TEST(TieredPricing, FlatTableMatchesFlatCalculators) {
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> funds(0.0, 20000.0);
+    std::uniform_real_distribution<double> rate(0.0, 5.0);
+    std::uniform_real_distribution<double> storage(0.0, 3.0);
+    std::uniform_int_distribution<int> instances(1, 10);
+    std::uniform_int_distribution<int> hours(0, 1000);
+
+    for (int i = 0; i < 2000; i++) {
+        double r = i % 5 == 0 ? 0.0 : rate(rng);
+        double s = i % 7 == 0 ? 0.0 : storage(rng);
+        double f = funds(rng);
+        int n = instances(rng);
+        int h = hours(rng);
+        TieredRateTable table(r);
+
+        // TC1: Total cost
+        ASSERT_NEAR(calculateTotalCost(r, n, h, s), calculateTieredTotalCost(table, n, h, s), EPSILON);
+
+        // TC2: Duration, including the zero-rate and zero-storage special cases
+        ASSERT_NEAR(calculateFundsDuration(f, r, n, s), calculateTieredFundsDuration(f, table, n, s), EPSILON)
+            << f << " " << r << " " << n << " " << s;
+    }
+
+    // TC3: Fleet total
+    std::vector<GpuModel> gpuModels = {GpuModel("Test1", 2.0, 1.0, 2), GpuModel("Test2", 3.0, 1.5, 3)};
+    std::vector<TieredRateTable> tables = {TieredRateTable(2.0), TieredRateTable(3.0)};
+    EXPECT_NEAR(calculateTotalCostMultipleGpus(gpuModels, 50),
+                calculateTieredTotalCostMultipleGpus(gpuModels, tables, 50), EPSILON);
+}
+
+// 2. Negotiated tiers
+TEST(TieredPricing, VolumeAndHourTiers) {
+    // 1-3 instances: $2.00, then $1.50 after 100 hours; 4+ instances: $1.80, then $1.20
+    TieredRateTable table({1, 4}, {0, 100}, {2.0, 1.5, 1.8, 1.2});
+
+    // TC1: Lookups
+    EXPECT_NEAR(2.0, table.hourlyRateAt(3, 99.0), EPSILON);
+    EXPECT_NEAR(1.5, table.hourlyRateAt(3, 100.0), EPSILON);
+    EXPECT_NEAR(1.2, table.hourlyRateAt(4, 500.0), EPSILON);
+    EXPECT_NEAR(200.0 + 75.0, table.runtimeCost(1, 150.0), EPSILON);
+    EXPECT_NEAR(150.0, table.hoursForRuntimeCost(1, 275.0), EPSILON);
+
+    // TC2: Total cost, 150 hours = 7 days of storage
+    EXPECT_NEAR(275.0 * 2 + 0.5 * 2 * 7, calculateTieredTotalCost(table, 2, 150, 0.5), EPSILON);
+    EXPECT_NEAR((180.0 + 60.0) * 4 + 0.5 * 4 * 7, calculateTieredTotalCost(table, 4, 150, 0.5), EPSILON);
+
+    // TC3: Fleet total replaces the flat hourly rate
+    std::vector<GpuModel> gpuModels = {GpuModel("A100", 9.9, 0.5, 2), GpuModel("V100", 9.9, 0.5, 4)};
+    std::vector<TieredRateTable> tables = {table, table};
+    EXPECT_NEAR(557.0 + 974.0, calculateTieredTotalCostMultipleGpus(gpuModels, tables, 150), EPSILON);
+
+    // TC4: Duration agrees with a day-by-day, hour-by-hour walk across tier changes
+    for (double funds : {0.5, 100.0, 250.0, 1000.0, 5000.0, 12345.0}) {
+        for (int instances : {1, 3, 4, 9}) {
+            EXPECT_NEAR(referenceDuration(funds, table, instances, 0.75),
+                        calculateTieredFundsDuration(funds, table, instances, 0.75), EPSILON)
+                << funds << " " << instances;
+        }
+    }
+
+    // TC5: A free last tier with no storage runs forever once reached
+    TieredRateTable freeTail({1}, {0, 10}, {1.0, 0.0});
+    EXPECT_NEAR(5.0, calculateTieredFundsDuration(5.0, freeTail, 1, 0.0), EPSILON);
+    EXPECT_NEAR(-1.0, calculateTieredFundsDuration(10.0, freeTail, 1, 0.0), EPSILON);
+}
+
+TEST(TieredPricing, InputValidation) {
+    // TC1: Malformed tables
+    EXPECT_THROW(TieredRateTable({}, {0}, {}), std::invalid_argument);
+    EXPECT_THROW(TieredRateTable({2}, {0}, {1.0}), std::invalid_argument);
+    EXPECT_THROW(TieredRateTable({1}, {0, 0}, {1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(TieredRateTable({1, 4}, {0}, {1.0}), std::invalid_argument);
+    EXPECT_THROW(TieredRateTable({1}, {0}, {-1.0}), std::invalid_argument);
+    EXPECT_THROW(TieredRateTable({1}, {0, 1, 2, 3, 4, 5, 6, 7, 8}, std::vector<double>(9, 1.0)),
+                 std::invalid_argument);
+
+    // TC2: Calculator inputs
+    TieredRateTable table(1.0);
+    EXPECT_THROW(calculateTieredTotalCost(table, 0, 1, 0.0), std::invalid_argument);
+    EXPECT_THROW(calculateTieredFundsDuration(-1.0, table, 1, 0.0), std::invalid_argument);
+    EXPECT_THROW(calculateTieredTotalCostMultipleGpus({GpuModel("A100", 1.0, 0.5, 1)}, {}, 1), std::invalid_argument);
+}
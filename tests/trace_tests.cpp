@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/gpu_model.h"
+#include "../src/trace.h"
+
+// 1. Recording spans
+TEST(Trace, RecordsOnlyWhenEnabled) {
+    clearTrace();
+
+    // TC1: Disabled tracing records nothing
+    setTracingEnabled(false);
+    { TraceSpan span("disabled"); }
+    EXPECT_TRUE(collectTraceEvents().empty());
+
+    // TC2: Nested spans on two threads
+    setTracingEnabled(true);
+    {
+        TraceSpan outer("outer");
+        { TraceSpan inner("inner"); }
+    }
+    std::thread worker([]() { TraceSpan span("worker"); });
+    worker.join();
+    setTracingEnabled(false);
+
+    std::vector<TraceEvent> events = collectTraceEvents();
+    ASSERT_EQ(3u, events.size());
+    EXPECT_STREQ("inner", events[0].name);
+    EXPECT_STREQ("outer", events[1].name);
+    EXPECT_LE(events[1].startNanos, events[0].startNanos);
+    EXPECT_GE(events[1].durationNanos, events[0].durationNanos);
+    EXPECT_NE(events[0].threadId, events[2].threadId);
+    clearTrace();
+}
+
+TEST(Trace, RingKeepsNewestSpans) {
+    clearTrace();
+    setTracingEnabled(true);
+    for (std::size_t i = 0; i < TRACE_RING_CAPACITY + 10; i++) {
+        TraceSpan span(i < 10 ? "old" : "new");
+    }
+    setTracingEnabled(false);
+
+    // TC1: The ten oldest spans were overwritten
+    std::vector<TraceEvent> events = collectTraceEvents();
+    EXPECT_EQ(TRACE_RING_CAPACITY, events.size());
+    for (const TraceEvent& event : events) {
+        ASSERT_STREQ("new", event.name);
+    }
+    clearTrace();
+}
+
+// 2. Output
+TEST(Trace, WritesChromeTraceJson) {
+    clearTrace();
+    setTracingEnabled(true);
+    { TraceSpan span("pricing \"batch\""); }
+    setTracingEnabled(false);
+
+    // TC1: One complete event with escaped name and allocation args
+    std::ostringstream out;
+    writeChromeTrace(out);
+    std::string json = out.str();
+    EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"pricing \\\"batch\\\"\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"allocations\":"));
+    clearTrace();
+}
+
+#ifdef VASTGPU_TRACING
+// 3. Allocation attribution (hooks are only built into tracing builds)
+TEST(Trace, AttributesAllocationsToSpans) {
+    clearTrace();
+    std::vector<GpuModel> gpuModels;
+    gpuModels.reserve(8);
+    GpuModel gpu("A-model-name-longer-than-the-small-string-buffer", 1.0, 0.5, 1);
+
+    setTracingEnabled(true);
+    {
+        TraceSpan span("copies");
+        gpuModels.push_back(gpu);
+        std::string name = gpu.getName();
+    }
+    setTracingEnabled(false);
+
+    // TC1: The GpuModel copy and the name copy each allocate a string
+    std::vector<TraceEvent> events = collectTraceEvents();
+    ASSERT_EQ(1u, events.size());
+    EXPECT_EQ(2u, events[0].allocations);
+    EXPECT_GE(events[0].allocatedBytes, 2 * gpu.getName().size());
+    clearTrace();
+}
+#endif
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/funds_calculator.h"
+#include "../src/gpu_model.h"
+#include "../src/tracker_snapshot.h"
+
+const double EPSILON = 0.001;
+
+static TrackerState makeState() {
+    TrackerState state;
+    state.initialFunds = 1000.0;
+    state.runningTimeHours = 50;
+    state.gpuModels = {
+        GpuModel("Test1", 2.0, 1.0, 2),
+        GpuModel("Test2", 3.0, 1.5, 3),
+        GpuModel("A-much-longer-model-name-than-usual", 1.0, 0.5, 1),
+    };
+    return state;
+}
+
+static void corruptByte(const std::string& path, std::streamoff offset, char value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset);
+    file.write(&value, 1);
+}
+
+// 1. Save and restore
+TEST(TrackerSnapshot, RoundTrip) {
+    std::string path = testing::TempDir() + "tracker_roundtrip.snap";
+    TrackerState state = makeState();
+    saveSnapshot(path, state);
+
+    SnapshotView snapshot(path);
+
+    // TC1: Scalars and fleet come back unchanged
+    EXPECT_NEAR(1000.0, snapshot.getInitialFunds(), EPSILON);
+    EXPECT_EQ(50, snapshot.getRunningTimeHours());
+    ASSERT_EQ(3u, snapshot.size());
+    EXPECT_EQ("A-much-longer-model-name-than-usual", snapshot.nameOf(2));
+    EXPECT_EQ(3, snapshot.begin()[1].getNumInstances());
+    EXPECT_THROW(snapshot.nameOf(3), std::out_of_range);
+
+    // TC2: Range calculators run over the mapped records
+    EXPECT_NEAR(721.0, calculateTotalCostMultipleGpus(snapshot.begin(), snapshot.end(), 50), EPSILON);
+
+    // TC3: Cached aggregates reproduce the multi-GPU runway
+    EXPECT_EQ(6, snapshot.getAggregates().totalInstances);
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(1000.0, state.gpuModels), snapshot.cachedFundsDuration(), EPSILON);
+
+    // TC4: toState copies everything back
+    TrackerState restored = snapshot.toState();
+    ASSERT_EQ(state.gpuModels.size(), restored.gpuModels.size());
+    for (std::size_t i = 0; i < state.gpuModels.size(); i++) {
+        EXPECT_EQ(state.gpuModels[i].getName(), restored.gpuModels[i].getName());
+        EXPECT_EQ(state.gpuModels[i].getHourlyRate(), restored.gpuModels[i].getHourlyRate());
+        EXPECT_EQ(state.gpuModels[i].getDailyStorageCost(), restored.gpuModels[i].getDailyStorageCost());
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TrackerSnapshot, ConcurrentSaves) {
+    std::filesystem::path directory = std::filesystem::path(testing::TempDir()) / "tracker_concurrent";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::string path = (directory / "tracker.snap").string();
+
+    // TC1: Saves racing on one path each write their own temp file; whichever renames last
+    // leaves a complete snapshot and no temp file is left behind
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([&path, t]() {
+            TrackerState state = makeState();
+            state.runningTimeHours = 100 + t;
+            for (int i = 0; i < 20; i++) {
+                saveSnapshot(path, state);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    SnapshotView snapshot(path);
+    EXPECT_EQ(3u, snapshot.size());
+    EXPECT_GE(snapshot.getRunningTimeHours(), 100);
+    EXPECT_LE(snapshot.getRunningTimeHours(), 103);
+    std::size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        (void)(entry);
+        files++;
+    }
+    EXPECT_EQ(1u, files);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(TrackerSnapshot, LargeFleet) {
+    std::string path = testing::TempDir() + "tracker_large.snap";
+    TrackerState state;
+    state.initialFunds = 5000.0;
+    for (int i = 0; i < 200000; i++) {
+        state.gpuModels.push_back(GpuModel("GPU" + std::to_string(i % 50), 0.5, 0.25, 1 + i % 3));
+    }
+    saveSnapshot(path, state);
+
+    // TC1: Records and names line up across the whole file
+    SnapshotView snapshot(path);
+    ASSERT_EQ(200000u, snapshot.size());
+    EXPECT_EQ("GPU49", snapshot.nameOf(199999));
+    EXPECT_NEAR(calculateFundsDurationMultipleGpus(5000.0, state.gpuModels), snapshot.cachedFundsDuration(), EPSILON);
+    std::remove(path.c_str());
+}
+
+// 2. Rejected files
+TEST(TrackerSnapshot, RejectsBadFiles) {
+    std::string path = testing::TempDir() + "tracker_bad.snap";
+
+    // TC1: Missing file
+    EXPECT_THROW(SnapshotView("/nonexistent/tracker.snap"), std::runtime_error);
+
+    // TC2: Wrong magic
+    saveSnapshot(path, makeState());
+    corruptByte(path, 0, 'X');
+    EXPECT_THROW(SnapshotView snapshot(path), std::runtime_error);
+
+    // TC3: Newer format version
+    saveSnapshot(path, makeState());
+    corruptByte(path, 8, (char)(SNAPSHOT_FORMAT_VERSION + 1));
+    EXPECT_THROW(SnapshotView snapshot(path), std::runtime_error);
+
+    // TC4: Truncated file
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "VGPUSNAP";
+    }
+    EXPECT_THROW(SnapshotView snapshot(path), std::runtime_error);
+    std::remove(path.c_str());
+}
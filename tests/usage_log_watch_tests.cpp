@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "../src/funds_calculator.h"
+#include "../src/usage_log_watch.h"
+
+const double EPSILON = 0.001;
+
+static void appendToLog(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::app | std::ios::binary);
+    out << text;
+}
+
+// 1. Incremental polling
+TEST(UsageLogFollower, AppliesOnlyAppendedLines) {
+    std::string path = testing::TempDir() + "usage_incremental.log";
+    std::remove(path.c_str());
+
+    UsageLogFollower follower(path, 1000.0);
+
+    // TC1: Log does not exist yet
+    EXPECT_EQ(0u, follower.poll());
+    EXPECT_NEAR(1000.0, follower.getRemainingFunds(), EPSILON);
+
+    // TC2: One complete line is charged through calculateTotalCost
+    appendToLog(path, "A100,1.0,0.5,5,50\n");
+    EXPECT_EQ(1u, follower.poll());
+    EXPECT_NEAR(742.5, follower.getRemainingFunds(), EPSILON);
+    EXPECT_NEAR(257.5, follower.getTotalCharged(), EPSILON);
+
+    // TC3: A partial line waits for its newline
+    std::uint64_t offset = follower.getOffset();
+    appendToLog(path, "H100,2.0,1.0,");
+    EXPECT_EQ(0u, follower.poll());
+    EXPECT_GT(follower.getOffset(), offset);
+    appendToLog(path, "2,50\n");
+    EXPECT_EQ(1u, follower.poll());
+    EXPECT_NEAR(742.5 - 206.0, follower.getRemainingFunds(), EPSILON);
+
+    // TC4: Nothing new, nothing applied
+    EXPECT_EQ(0u, follower.poll());
+    EXPECT_EQ(2u, follower.getRecordCount());
+
+    // TC5: Runway uses the latest configuration per model
+    double expected = calculateFundsDuration(follower.getRemainingFunds(), 1.0 * 5 + 2.0 * 2, 1, 0.5 * 5 + 1.0 * 2);
+    EXPECT_NEAR(expected, follower.getProjectedRunway(), EPSILON);
+    appendToLog(path, "A100,1.0,0.5,1,0\n");
+    follower.poll();
+    expected = calculateFundsDuration(follower.getRemainingFunds(), 1.0 + 2.0 * 2, 1, 0.5 + 1.0 * 2);
+    EXPECT_NEAR(expected, follower.getProjectedRunway(), EPSILON);
+
+    std::remove(path.c_str());
+}
+
+TEST(UsageLogFollower, InvalidLinesAndTruncation) {
+    std::string path = testing::TempDir() + "usage_invalid.log";
+    std::remove(path.c_str());
+    appendToLog(path, "# header comment\nA100,-1.0,0.5,5,50\nA100,1.0,0.5,5\nA100,1.0,0.5,5,-2\n");
+
+    UsageLogFollower follower(path, 100.0);
+
+    // TC1: Invalid lines are counted and skipped, with line numbers
+    EXPECT_EQ(3u, follower.poll());
+    EXPECT_EQ(0u, follower.getRecordCount());
+    EXPECT_EQ(3u, follower.getErrorCount());
+    EXPECT_EQ("line 4: Running hours can't be negative", follower.getLastError());
+    EXPECT_NEAR(100.0, follower.getRemainingFunds(), EPSILON);
+
+    // TC2: No billing configuration yet means no ongoing cost
+    EXPECT_NEAR(-1.0, follower.getProjectedRunway(), EPSILON);
+
+    // TC3: A shrinking log is rejected
+    { std::ofstream out(path, std::ios::trunc); }
+    EXPECT_THROW(follower.poll(), std::runtime_error);
+
+    // TC4: Negative initial funds
+    EXPECT_THROW(UsageLogFollower(path, -1.0), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+// 2. inotify watch loop
+TEST(WatchUsageLog, WakesOnAppend) {
+    std::string path = testing::TempDir() + "usage_watch.log";
+    std::remove(path.c_str());
+
+    UsageLogFollower follower(path, 1000.0);
+    std::atomic<bool> stop(false);
+    std::atomic<int> updates(0);
+
+    std::thread watcher([&]() {
+        watchUsageLog(follower, [&](const UsageLogFollower&) { updates++; }, stop);
+    });
+
+    // TC1: The tempfile writer's appends reach the follower
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    appendToLog(path, "A100,1.0,0.5,5,50\n");
+    for (int i = 0; i < 200 && updates.load() < 1; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    appendToLog(path, "A100,1.0,0.5,5,50\n");
+    for (int i = 0; i < 200 && follower.getRecordCount() < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    stop = true;
+    watcher.join();
+    EXPECT_GE(updates.load(), 1);
+    EXPECT_EQ(2u, follower.getRecordCount());
+    EXPECT_NEAR(1000.0 - 2 * 257.5, follower.getRemainingFunds(), EPSILON);
+    std::remove(path.c_str());
+}